@@ -27,6 +27,11 @@
 #define global         static
 #define internal       static
 #define local_persist  static
+#if _MSC_VER
+#define per_thread     __declspec(thread)
+#else
+#define per_thread     __thread
+#endif
 #define ArrayCount(a) (sizeof(a) / sizeof((a)[0]))
 #define Bytes(n)      (n)
 #define Kilobytes(n)  (n << 10)
@@ -34,6 +39,15 @@
 #define Gigabytes(n)  (((u64)n) << 30)
 #define Terabytes(n)  (((u64)n) << 40)
 #define PI (3.1415926535897f)
+#define Min(a, b)     ((a) < (b) ? (a) : (b))
+#define Max(a, b)     ((a) > (b) ? (a) : (b))
+#define IsPow2(x)     (((x) != 0) && (((x) & ((x)-1)) == 0))
+#define AlignPow2(x, a) (((x) + (a) - 1) & ~((u64)(a) - 1))
+#if _MSC_VER
+#define AlignOf(T)    __alignof(T)
+#else
+#define AlignOf(T)    _Alignof(T)
+#endif
 
 //~ NOTE(rjf): Base Types
 
@@ -56,6 +70,177 @@ typedef i64      b64;
 typedef float    f32;
 typedef double   f64;
 
+//~ NOTE(rjf): Atomics
+
+// NOTE(rjf): All of the read-modify-write operations are full barriers and
+// return the value that was in memory before the operation.
+#if _MSC_VER
+#include <intrin.h>
+#define AtomicLoadU64(p)                 (*(volatile u64 *)(p))
+#define AtomicStoreU64(p, v)             (*(volatile u64 *)(p) = (v))
+#define AtomicAddU64(p, v)               ((u64)_InterlockedExchangeAdd64((volatile __int64 *)(p), (__int64)(v)))
+#define AtomicCompareExchangeU64(p, e, c) ((u64)_InterlockedCompareExchange64((volatile __int64 *)(p), (__int64)(e), (__int64)(c)))
+#define AtomicLoadU32(p)                 (*(volatile u32 *)(p))
+#define AtomicStoreU32(p, v)             (*(volatile u32 *)(p) = (v))
+#define AtomicAddU32(p, v)               ((u32)_InterlockedExchangeAdd((volatile long *)(p), (long)(v)))
+#define AtomicCompareExchangeU32(p, e, c) ((u32)_InterlockedCompareExchange((volatile long *)(p), (long)(e), (long)(c)))
+#define SpinPause()                      _mm_pause()
+#else
+#include <immintrin.h>
+#define AtomicLoadU64(p)                 __atomic_load_n((volatile u64 *)(p), __ATOMIC_ACQUIRE)
+#define AtomicStoreU64(p, v)             __atomic_store_n((volatile u64 *)(p), (v), __ATOMIC_RELEASE)
+#define AtomicAddU64(p, v)               __atomic_fetch_add((volatile u64 *)(p), (v), __ATOMIC_SEQ_CST)
+#define AtomicCompareExchangeU64(p, e, c) __sync_val_compare_and_swap((volatile u64 *)(p), (c), (e))
+#define AtomicLoadU32(p)                 __atomic_load_n((volatile u32 *)(p), __ATOMIC_ACQUIRE)
+#define AtomicStoreU32(p, v)             __atomic_store_n((volatile u32 *)(p), (v), __ATOMIC_RELEASE)
+#define AtomicAddU32(p, v)               __atomic_fetch_add((volatile u32 *)(p), (v), __ATOMIC_SEQ_CST)
+#define AtomicCompareExchangeU32(p, e, c) __sync_val_compare_and_swap((volatile u32 *)(p), (c), (e))
+#define SpinPause()                      _mm_pause()
+#endif
+
+//~ NOTE(rjf): Bit Scanning
+
+// NOTE(rjf): Index of the lowest/highest set bit. Undefined for zero.
+#if _MSC_VER
+internal u32
+LowestSetBitU32(u32 x)
+{
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return (u32)index;
+}
+
+internal u32
+LowestSetBitU64(u64 x)
+{
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (u32)index;
+}
+
+internal u32
+HighestSetBitU32(u32 x)
+{
+    unsigned long index;
+    _BitScanReverse(&index, x);
+    return (u32)index;
+}
+
+internal u32
+HighestSetBitU64(u64 x)
+{
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return (u32)index;
+}
+#else
+internal u32
+LowestSetBitU32(u32 x)
+{
+    return (u32)__builtin_ctz(x);
+}
+
+internal u32
+LowestSetBitU64(u64 x)
+{
+    return (u32)__builtin_ctzll(x);
+}
+
+internal u32
+HighestSetBitU32(u32 x)
+{
+    return 31 - (u32)__builtin_clz(x);
+}
+
+internal u32
+HighestSetBitU64(u64 x)
+{
+    return 63 - (u32)__builtin_clzll(x);
+}
+#endif
+
+//~ NOTE(rjf): CPU Features
+
+// NOTE(rjf): Code that uses instructions past the x64 baseline (SSE2) goes in
+// functions marked with the matching TARGET_ macro, and is only called after
+// checking CPUHas. MSVC doesn't need the attribute to emit them.
+#if _MSC_VER
+#define TARGET_AVX2
+#define TARGET_PCLMUL
+#else
+#include <cpuid.h>
+#define TARGET_AVX2   __attribute__((target("avx2")))
+#define TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+#endif
+
+typedef u32 CPUFeatures;
+enum
+{
+    CPUFeature_AVX2     = (1<<0),
+    
+    // NOTE(rjf): Carry-less multiply, along with the SSE4.1 that code using
+    // it always needs.
+    CPUFeature_PCLMUL   = (1<<1),
+    CPUFeature_Detected = (1<<31),
+};
+
+global CPUFeatures global_cpu_features = 0;
+
+internal void
+CPUID(u32 leaf, u32 subleaf, u32 *registers)
+{
+#if _MSC_VER
+    __cpuidex((int *)registers, (int)leaf, (int)subleaf);
+#else
+    __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+internal CPUFeatures
+GetCPUFeatures(void)
+{
+    if(!(global_cpu_features & CPUFeature_Detected))
+    {
+        CPUFeatures features = CPUFeature_Detected;
+        u32 registers[4] = {0};
+        CPUID(0, 0, registers);
+        u32 max_leaf = registers[0];
+        CPUID(1, 0, registers);
+        if((registers[2] & (1<<1)) && (registers[2] & (1<<19)))
+        {
+            features |= CPUFeature_PCLMUL;
+        }
+        
+        // NOTE(rjf): AVX state has to be enabled by the OS (OSXSAVE, and the
+        // XMM/YMM bits of XCR0) as well as supported by the CPU.
+        b32 os_avx = 0;
+        if(registers[2] & (1<<27))
+        {
+#if _MSC_VER
+            u64 xcr0 = _xgetbv(0);
+#else
+            u32 xcr0_low = 0;
+            u32 xcr0_high = 0;
+            __asm__ volatile("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+            u64 xcr0 = ((u64)xcr0_high << 32) | xcr0_low;
+#endif
+            os_avx = (xcr0 & 6) == 6;
+        }
+        if(os_avx && max_leaf >= 7)
+        {
+            CPUID(7, 0, registers);
+            if(registers[1] & (1<<5))
+            {
+                features |= CPUFeature_AVX2;
+            }
+        }
+        global_cpu_features = features;
+    }
+    return global_cpu_features;
+}
+
+#define CPUHas(feature) (!!(GetCPUFeatures() & CPUFeature_##feature))
+
 //~ NOTE(rjf): Random Number Generation
 
 internal void
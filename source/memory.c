@@ -1,42 +1,286 @@
-#define M_ARENA_MAX          Gigabytes(4)
-#define M_ARENA_COMMIT_SIZE  Kilobytes(4)
+#define M_ARENA_MAX                   Gigabytes(4)
+#define M_ARENA_COMMIT_SIZE           Kilobytes(4)
+#define M_ARENA_COMMIT_CHUNK_SIZE     Kilobytes(64)
+#define M_ARENA_COMMIT_GROWTH_MAX     Megabytes(64)
+#define M_ARENA_DECOMMIT_CLEAR_COUNT  16
+#define M_ARENA_SIMD_ALIGN            16
+#define M_CACHE_LINE_SIZE             64
+#define M_SCRATCH_ARENA_COUNT         2
+
+internal M_ArenaParams
+M_ArenaDefaultParams(void)
+{
+    M_ArenaParams params = {0};
+    params.flags = 0;
+    params.reserve_size = M_ARENA_MAX;
+    params.commit_chunk_size = M_ARENA_COMMIT_CHUNK_SIZE;
+    params.commit_growth = 1.f;
+    params.decommit_clear_count = M_ARENA_DECOMMIT_CLEAR_COUNT;
+    return params;
+}
 
 internal M_Arena
-M_ArenaInitialize(void)
+M_ArenaInitializeWithParams(M_ArenaParams *params)
 {
     M_Arena arena = {0};
-    arena.max = M_ARENA_MAX;
-    arena.base = os->Reserve(arena.max);
+    arena.flags = params->flags;
+    arena.max = params->reserve_size;
+    arena.commit_growth = params->commit_growth < 1.f ? 1.f : params->commit_growth;
+    arena.decommit_clear_count = params->decommit_clear_count;
+    if(arena.decommit_clear_count > M_ARENA_CLEAR_HISTORY_MAX)
+    {
+        arena.decommit_clear_count = M_ARENA_CLEAR_HISTORY_MAX;
+    }
+    
+    // NOTE(rjf): Chunks are whole pages.
+    arena.commit_chunk_size = params->commit_chunk_size;
+    arena.commit_chunk_size += M_ARENA_COMMIT_SIZE-1;
+    arena.commit_chunk_size -= arena.commit_chunk_size % M_ARENA_COMMIT_SIZE;
+    if(arena.commit_chunk_size == 0)
+    {
+        arena.commit_chunk_size = M_ARENA_COMMIT_SIZE;
+    }
+    
+    if(arena.flags & M_ArenaFlag_LargePages && os->large_page_size)
+    {
+        // NOTE(rjf): Large pages can't be committed piecemeal, so the whole
+        // reserve is committed here and never decommitted.
+        arena.max += os->large_page_size-1;
+        arena.max -= arena.max % os->large_page_size;
+        arena.base = os->ReserveLargePages(arena.max);
+        if(arena.base)
+        {
+            arena.commit_position = arena.max;
+            arena.decommit_clear_count = 0;
+        }
+    }
+    
+    if(!arena.base)
+    {
+        arena.flags &= ~M_ArenaFlag_LargePages;
+        arena.max = params->reserve_size;
+        arena.base = os->Reserve(arena.max);
+    }
+    
     arena.alloc_position = 0;
-    arena.commit_position = 0;
     return arena;
 }
 
-internal void *
-M_ArenaPush(M_Arena *arena, u64 size)
+internal M_Arena
+M_ArenaInitialize(void)
 {
-    void *memory = 0;
-    if(arena->alloc_position + size > arena->commit_position)
+    M_ArenaParams params = M_ArenaDefaultParams();
+    return M_ArenaInitializeWithParams(&params);
+}
+
+internal void
+M_ArenaSetDecommitClearCount(M_Arena *arena, u32 clear_count)
+{
+    if(clear_count > M_ARENA_CLEAR_HISTORY_MAX)
+    {
+        clear_count = M_ARENA_CLEAR_HISTORY_MAX;
+    }
+    if(arena->flags & M_ArenaFlag_LargePages)
+    {
+        clear_count = 0;
+    }
+    arena->decommit_clear_count = clear_count;
+    arena->clear_peak_index = 0;
+    MemorySet(arena->clear_peaks, 0, sizeof(arena->clear_peaks));
+}
+
+#if M_ARENA_INSTRUMENT
+global per_thread char *global_arena_callsite_file;
+global per_thread u32 global_arena_callsite_line;
+
+internal void
+M_ArenaSetCallsite(char *file, u32 line)
+{
+    global_arena_callsite_file = file;
+    global_arena_callsite_line = line;
+}
+
+internal void
+M_ArenaRecordPush(M_Arena *arena, u64 size)
+{
+    char *file = global_arena_callsite_file;
+    u32 line = global_arena_callsite_line;
+    global_arena_callsite_file = 0;
+    
+    b32 recorded = 0;
+    if(file)
+    {
+        u64 hash = ((u64)file >> 4) * 31 + line;
+        for(u32 probe = 0; probe < M_ARENA_CALLSITE_MAX; ++probe)
+        {
+            M_ArenaCallsite *callsite = arena->callsites + (hash + probe) % M_ARENA_CALLSITE_MAX;
+            if(!callsite->file)
+            {
+                callsite->file = file;
+                callsite->line = line;
+            }
+            if(callsite->file == file && callsite->line == line)
+            {
+                callsite->push_count += 1;
+                callsite->bytes += size;
+                recorded = 1;
+                break;
+            }
+        }
+    }
+    if(!recorded)
+    {
+        arena->untracked_bytes += size;
+    }
+    if(arena->alloc_position > arena->peak_position)
+    {
+        arena->peak_position = arena->alloc_position;
+    }
+}
+
+#define M_ArenaSetName(arena, string) ((arena)->name = (string))
+#else
+#define M_ArenaSetName(arena, string)
+#endif
+
+// NOTE(rjf): Commits the arena up to at least end without handing anything
+// out, for callers that want to write into the committed tail before they
+// know how much of it they'll keep.
+internal void
+M_ArenaEnsureCommitted(M_Arena *arena, u64 end)
+{
+    if(end > arena->commit_position)
     {
-        u64 commit_size = size;
-        commit_size += M_ARENA_COMMIT_SIZE-1;
-        commit_size -= commit_size % M_ARENA_COMMIT_SIZE;
-        os->Commit((u8 *)arena->base + arena->commit_position, commit_size);
+        u64 commit_size = end - arena->commit_position;
+        
+        // NOTE(rjf): Geometric growth, capped so huge arenas don't overshoot
+        // by gigabytes.
+        u64 growth_size = (u64)(arena->commit_position * (arena->commit_growth - 1.f));
+        if(growth_size > M_ARENA_COMMIT_GROWTH_MAX)
+        {
+            growth_size = M_ARENA_COMMIT_GROWTH_MAX;
+        }
+        if(commit_size < growth_size)
+        {
+            commit_size = growth_size;
+        }
+        
+        commit_size += arena->commit_chunk_size-1;
+        commit_size -= commit_size % arena->commit_chunk_size;
+        if(arena->commit_position + commit_size > arena->max)
+        {
+            commit_size = arena->max - arena->commit_position;
+        }
+        
+        u8 *commit_base = (u8 *)arena->base + arena->commit_position;
+        os->Commit(commit_base, commit_size);
+        if(arena->flags & M_ArenaFlag_Prefault)
+        {
+            for(u64 offset = 0; offset < commit_size; offset += M_ARENA_COMMIT_SIZE)
+            {
+                ((volatile u8 *)commit_base)[offset] = 0;
+            }
+        }
         arena->commit_position += commit_size;
     }
+}
+
+internal void *
+M_ArenaPush(M_Arena *arena, u64 size)
+{
+    void *memory = 0;
+    M_ArenaEnsureCommitted(arena, arena->alloc_position + size);
     memory = (u8 *)arena->base + arena->alloc_position;
     arena->alloc_position += size;
+    if(arena->alloc_position > arena->zero_position)
+    {
+        arena->zero_position = arena->alloc_position;
+    }
+    if(arena->alloc_position > arena->clear_peak_position)
+    {
+        arena->clear_peak_position = arena->alloc_position;
+    }
+#if M_ARENA_INSTRUMENT
+    M_ArenaRecordPush(arena, size);
+#endif
     return memory;
 }
 
 internal void *
-M_ArenaPushZero(M_Arena *arena, u64 size)
+M_ArenaPushAligned(M_Arena *arena, u64 size, u64 align)
+{
+    // NOTE(rjf): The base comes straight from os->Reserve, so it is page
+    // aligned, and aligning the offset aligns the address.
+    HardAssert(IsPow2(align));
+    u64 padding = AlignPow2(arena->alloc_position, align) - arena->alloc_position;
+    u8 *memory = (u8 *)M_ArenaPush(arena, padding + size) + padding;
+    return memory;
+}
+
+internal void *
+M_ArenaPushZeroAligned(M_Arena *arena, u64 size, u64 align)
 {
-    void *memory = M_ArenaPush(arena, size);
-    MemorySet(memory, 0, size);
+    // NOTE(rjf): Only the part of the range that was handed out before needs
+    // clearing; freshly committed pages come back from the OS zeroed.
+    u64 dirty_end = arena->zero_position;
+    void *memory = M_ArenaPushAligned(arena, size, align);
+    u64 start = (u8 *)memory - (u8 *)arena->base;
+    if(dirty_end > start)
+    {
+        u64 dirty_size = dirty_end - start;
+        if(dirty_size > size)
+        {
+            dirty_size = size;
+        }
+        MemorySet(memory, 0, dirty_size);
+    }
     return memory;
 }
 
+internal void *
+M_ArenaPushZero(M_Arena *arena, u64 size)
+{
+    return M_ArenaPushZeroAligned(arena, size, 1);
+}
+
+internal void *
+M_ArenaPushCacheAligned(M_Arena *arena, u64 size)
+{
+    return M_ArenaPushAligned(arena, size, M_CACHE_LINE_SIZE);
+}
+
+// NOTE(rjf): Allocates count elements for each of array_count parallel
+// arrays in one push. Every array starts on an align boundary (at least a
+// cache line), so no two arrays share a cache line and all of them can be
+// read with aligned SIMD loads.
+internal void
+M_ArenaPushSoA(M_Arena *arena, u64 count, u32 array_count, u64 *element_sizes, void **arrays, u64 align)
+{
+    align = Max(align, M_CACHE_LINE_SIZE);
+    u64 total_size = 0;
+    for(u32 i = 0; i < array_count; ++i)
+    {
+        total_size = AlignPow2(total_size, align);
+        total_size += element_sizes[i]*count;
+    }
+    u8 *memory = M_ArenaPushAligned(arena, total_size, align);
+    u64 offset = 0;
+    for(u32 i = 0; i < array_count; ++i)
+    {
+        offset = AlignPow2(offset, align);
+        arrays[i] = memory + offset;
+        offset += element_sizes[i]*count;
+    }
+}
+
+// NOTE(rjf): Typed pushes are aligned to at least M_ARENA_SIMD_ALIGN, so
+// v4/m4 data can always be loaded with aligned SSE loads.
+#define M_TypeAlign(T)                      Max(AlignOf(T), M_ARENA_SIMD_ALIGN)
+#define M_PushArray(arena, T, count)        ((T *)M_ArenaPushAligned((arena), sizeof(T)*(count), M_TypeAlign(T)))
+#define M_PushArrayZero(arena, T, count)    ((T *)M_ArenaPushZeroAligned((arena), sizeof(T)*(count), M_TypeAlign(T)))
+#define M_PushStruct(arena, T)              M_PushArray((arena), T, 1)
+#define M_PushStructZero(arena, T)          M_PushArrayZero((arena), T, 1)
+
 internal void
 M_ArenaPop(M_Arena *arena, u64 size)
 {
@@ -51,10 +295,1462 @@ internal void
 M_ArenaClear(M_Arena *arena)
 {
     M_ArenaPop(arena, arena->alloc_position);
+    
+#if M_ARENA_INSTRUMENT
+    arena->untracked_bytes = 0;
+    MemorySet(arena->callsites, 0, sizeof(arena->callsites));
+#endif
+    
+    // NOTE(rjf): Decommit everything above the rolling high-water mark.
+    if(arena->decommit_clear_count)
+    {
+        arena->clear_peaks[arena->clear_peak_index] = arena->clear_peak_position;
+        arena->clear_peak_index = (arena->clear_peak_index + 1) % arena->decommit_clear_count;
+        arena->clear_peak_position = 0;
+        
+        u64 high_water = 0;
+        for(u32 i = 0; i < arena->decommit_clear_count; ++i)
+        {
+            if(arena->clear_peaks[i] > high_water)
+            {
+                high_water = arena->clear_peaks[i];
+            }
+        }
+        
+        // NOTE(rjf): Keep some headroom above the high-water mark, so normal
+        // frame-to-frame jitter doesn't bounce between commit and decommit.
+        high_water += high_water / 4;
+        high_water += arena->commit_chunk_size-1;
+        high_water -= high_water % arena->commit_chunk_size;
+        
+        if(arena->commit_position > high_water)
+        {
+            os->Decommit((u8 *)arena->base + high_water, arena->commit_position - high_water);
+            arena->commit_position = high_water;
+            if(arena->zero_position > high_water)
+            {
+                arena->zero_position = high_water;
+            }
+        }
+    }
 }
 
 internal void
 M_ArenaRelease(M_Arena *arena)
 {
     os->Release(arena->base);
-}
\ No newline at end of file
+}
+
+//~ NOTE(rjf): Temporary Memory
+
+internal M_Temp
+M_BeginTemp(M_Arena *arena)
+{
+    M_Temp temp = {0};
+    temp.arena = arena;
+    temp.position = arena->alloc_position;
+    return temp;
+}
+
+internal void
+M_EndTemp(M_Temp temp)
+{
+    if(temp.arena->alloc_position > temp.position)
+    {
+        M_ArenaPop(temp.arena, temp.arena->alloc_position - temp.position);
+    }
+}
+
+//~ NOTE(rjf): Scratch Arenas
+
+global per_thread M_Arena global_scratch_arenas[M_SCRATCH_ARENA_COUNT];
+
+// NOTE(rjf): Returns a temp scope on one of this thread's scratch arenas,
+// skipping any arena in conflicts. A function that takes an arena to push
+// its results into should pass it as a conflict, so its own scratch
+// allocations can't be interleaved with (and popped out from under) the
+// results it returns.
+internal M_Temp
+M_GetScratch(M_Arena **conflicts, u32 conflict_count)
+{
+    M_Temp temp = {0};
+    for(u32 i = 0; i < M_SCRATCH_ARENA_COUNT; ++i)
+    {
+        M_Arena *arena = global_scratch_arenas + i;
+        b32 is_conflict = 0;
+        for(u32 j = 0; j < conflict_count; ++j)
+        {
+            if(conflicts[j] == arena)
+            {
+                is_conflict = 1;
+                break;
+            }
+        }
+        if(!is_conflict)
+        {
+            if(!arena->base)
+            {
+                *arena = M_ArenaInitialize();
+            }
+            temp = M_BeginTemp(arena);
+            break;
+        }
+    }
+    HardAssert(temp.arena != 0);
+    return temp;
+}
+
+#define M_ReleaseScratch(temp) M_EndTemp(temp)
+
+//~ NOTE(rjf): Arena Pools
+
+internal void
+M_ArenaPoolSetClass(M_ArenaPool *pool, u32 class_index, u64 reserve_size, u64 warm_size)
+{
+    HardAssert(class_index < M_ARENA_POOL_CLASS_MAX);
+    M_ArenaPoolClass *pool_class = pool->classes + class_index;
+    
+    // NOTE(rjf): Arenas reserved for the old size can't be served any more.
+    for(u32 i = 0; i < pool_class->free_count; ++i)
+    {
+        M_ArenaRelease(pool_class->free_arenas + i);
+    }
+    pool_class->free_count = 0;
+    pool_class->reserve_size = reserve_size;
+    pool_class->warm_size = Min(AlignPow2(warm_size, M_ARENA_COMMIT_SIZE), reserve_size);
+    if(class_index >= pool->class_count)
+    {
+        pool->class_count = class_index+1;
+    }
+}
+
+internal void
+M_ArenaPoolInitialize(M_ArenaPool *pool)
+{
+    MemorySet(pool, 0, sizeof(*pool));
+    M_ArenaPoolSetClass(pool, 0, Megabytes(64),  Kilobytes(64));
+    M_ArenaPoolSetClass(pool, 1, Megabytes(512), Kilobytes(256));
+    M_ArenaPoolSetClass(pool, 2, M_ARENA_MAX,    Megabytes(1));
+}
+
+internal M_ArenaPoolClass *
+M_ArenaPoolClassFromReserveSize(M_ArenaPool *pool, u64 reserve_size)
+{
+    M_ArenaPoolClass *result = 0;
+    for(u32 i = 0; i < pool->class_count; ++i)
+    {
+        M_ArenaPoolClass *pool_class = pool->classes + i;
+        if(pool_class->reserve_size >= reserve_size &&
+           (!result || pool_class->reserve_size < result->reserve_size))
+        {
+            result = pool_class;
+        }
+    }
+    return result;
+}
+
+internal M_Arena
+M_ArenaPoolAcquire(M_ArenaPool *pool, u64 reserve_size)
+{
+    M_Arena arena = {0};
+    M_ArenaPoolClass *pool_class = M_ArenaPoolClassFromReserveSize(pool, reserve_size);
+    if(pool_class && pool_class->free_count)
+    {
+        arena = pool_class->free_arenas[--pool_class->free_count];
+    }
+    else
+    {
+        M_ArenaParams params = M_ArenaDefaultParams();
+        params.reserve_size = pool_class ? pool_class->reserve_size : reserve_size;
+        arena = M_ArenaInitializeWithParams(&params);
+        if(pool_class && pool_class->warm_size)
+        {
+            os->Commit(arena.base, pool_class->warm_size);
+            arena.commit_position = pool_class->warm_size;
+        }
+    }
+    return arena;
+}
+
+internal void
+M_ArenaPoolRelease(M_ArenaPool *pool, M_Arena *arena)
+{
+    M_ArenaPoolClass *pool_class = 0;
+    for(u32 i = 0; i < pool->class_count; ++i)
+    {
+        if(pool->classes[i].reserve_size == arena->max)
+        {
+            pool_class = pool->classes + i;
+            break;
+        }
+    }
+    
+    if(pool_class && pool_class->free_count < M_ARENA_POOL_CLASS_CAPACITY &&
+       !(arena->flags & M_ArenaFlag_LargePages))
+    {
+        // NOTE(rjf): Decommit down to the warm size. Everything else (policy,
+        // high-water history) starts fresh for the next owner.
+        if(arena->commit_position > pool_class->warm_size)
+        {
+            os->Decommit((u8 *)arena->base + pool_class->warm_size, arena->commit_position - pool_class->warm_size);
+            arena->commit_position = pool_class->warm_size;
+        }
+        
+        M_ArenaParams params = M_ArenaDefaultParams();
+        M_Arena *recycled = pool_class->free_arenas + pool_class->free_count++;
+        MemorySet(recycled, 0, sizeof(*recycled));
+        recycled->base = arena->base;
+        recycled->max = arena->max;
+        recycled->commit_position = arena->commit_position;
+        recycled->zero_position = Min(arena->zero_position, arena->commit_position);
+        recycled->commit_chunk_size = params.commit_chunk_size;
+        recycled->commit_growth = params.commit_growth;
+        recycled->decommit_clear_count = params.decommit_clear_count;
+    }
+    else
+    {
+        M_ArenaRelease(arena);
+    }
+    MemorySet(arena, 0, sizeof(*arena));
+}
+
+//~ NOTE(rjf): Concurrent Arenas
+
+#define M_CONCURRENT_ARENA_CHUNK_SIZE Kilobytes(16)
+
+internal M_ConcurrentArena
+M_ConcurrentArenaInitialize(u64 reserve_size, u64 chunk_size)
+{
+    M_ConcurrentArena arena = {0};
+    arena.max = reserve_size;
+    arena.base = os->Reserve(arena.max);
+    arena.chunk_size = chunk_size ? AlignPow2(chunk_size, M_CACHE_LINE_SIZE) : M_CONCURRENT_ARENA_CHUNK_SIZE;
+    arena.commit_chunk_size = Max(M_ARENA_COMMIT_CHUNK_SIZE, AlignPow2(arena.chunk_size, M_ARENA_COMMIT_SIZE));
+    arena.generation = 1;
+    return arena;
+}
+
+internal void
+M_ConcurrentArenaRelease(M_ConcurrentArena *arena)
+{
+    os->Release(arena->base);
+}
+
+internal b32
+M_ConcurrentArenaEnsureCommitted(M_ConcurrentArena *arena, u64 end)
+{
+    b32 result = 1;
+    if(end > arena->max)
+    {
+        result = 0;
+    }
+    else if(end > AtomicLoadU64(&arena->commit_position))
+    {
+        while(AtomicCompareExchangeU32(&arena->commit_lock, 1, 0) != 0)
+        {
+            SpinPause();
+        }
+        
+        // NOTE(rjf): Another thread may have committed past us while we
+        // were waiting for the lock.
+        u64 commit_position = arena->commit_position;
+        if(end > commit_position)
+        {
+            // NOTE(rjf): commit_chunk_size is page-aligned but not
+            // necessarily a power of two, so this is a plain round-up.
+            u64 commit_end = end + arena->commit_chunk_size-1;
+            commit_end -= commit_end % arena->commit_chunk_size;
+            commit_end = Min(commit_end, arena->max);
+            os->Commit((u8 *)arena->base + commit_position, commit_end - commit_position);
+            AtomicStoreU64(&arena->commit_position, commit_end);
+        }
+        
+        AtomicStoreU32(&arena->commit_lock, 0);
+    }
+    return result;
+}
+
+// NOTE(rjf): Safe to call from any number of threads at once, as long as
+// each thread uses its own cursor. Returns 0 when the reserve is exhausted.
+internal void *
+M_ConcurrentArenaPushAligned(M_ConcurrentArena *arena, M_ConcurrentArenaCursor *cursor, u64 size, u64 align)
+{
+    void *memory = 0;
+    HardAssert(IsPow2(align) && align <= M_CACHE_LINE_SIZE);
+    
+    u64 generation = AtomicLoadU64(&arena->generation);
+    if(cursor->generation != generation)
+    {
+        cursor->generation = generation;
+        cursor->position = cursor->end = 0;
+    }
+    
+    u64 position = AlignPow2(cursor->position, align);
+    if(position + size <= cursor->end)
+    {
+        memory = (u8 *)arena->base + position;
+        cursor->position = position + size;
+    }
+    else if(size > arena->chunk_size / 2)
+    {
+        // NOTE(rjf): Big pushes go straight to the shared counter, so they
+        // don't throw away the rest of the cursor's chunk.
+        u64 block_size = AlignPow2(size, M_CACHE_LINE_SIZE);
+        u64 start = AtomicAddU64(&arena->alloc_position, block_size);
+        if(M_ConcurrentArenaEnsureCommitted(arena, start + block_size))
+        {
+            memory = (u8 *)arena->base + start;
+        }
+    }
+    else
+    {
+        u64 start = AtomicAddU64(&arena->alloc_position, arena->chunk_size);
+        if(M_ConcurrentArenaEnsureCommitted(arena, start + arena->chunk_size))
+        {
+            cursor->position = start + size;
+            cursor->end = start + arena->chunk_size;
+            memory = (u8 *)arena->base + start;
+        }
+    }
+    
+    return memory;
+}
+
+internal void *
+M_ConcurrentArenaPush(M_ConcurrentArena *arena, M_ConcurrentArenaCursor *cursor, u64 size)
+{
+    return M_ConcurrentArenaPushAligned(arena, cursor, size, M_ARENA_SIMD_ALIGN);
+}
+
+// NOTE(rjf): Not safe to call while other threads are pushing; call it at a
+// point where all producers are known to be idle (e.g. between frames).
+// Cursors from before the clear notice the generation change and drop their
+// chunks on their next push.
+internal void
+M_ConcurrentArenaClear(M_ConcurrentArena *arena)
+{
+    AtomicStoreU64(&arena->alloc_position, 0);
+    AtomicAddU64(&arena->generation, 1);
+}
+
+//~ NOTE(rjf): Pools
+
+#define M_POOL_CACHE_CAPACITY 64
+#define M_POOL_CACHE_BATCH    32
+
+internal M_Pool
+M_PoolInitialize(u64 element_size, u64 element_align)
+{
+    M_Pool pool = {0};
+    pool.arena = M_ArenaInitialize();
+    pool.element_align = Max(element_align, sizeof(M_PoolFreeNode));
+    pool.element_size = AlignPow2(Max(element_size, sizeof(M_PoolFreeNode)), pool.element_align);
+    pool.generation = 1;
+    return pool;
+}
+
+#define M_PoolInitializeForType(T) M_PoolInitialize(sizeof(T), M_TypeAlign(T))
+
+internal void
+M_PoolRelease(M_Pool *pool)
+{
+    M_ArenaRelease(&pool->arena);
+    MemorySet(pool, 0, sizeof(*pool));
+}
+
+internal void *
+M_PoolAlloc(M_Pool *pool)
+{
+    void *memory = pool->free_list;
+    if(memory)
+    {
+        pool->free_list = pool->free_list->next;
+    }
+    else
+    {
+        memory = M_ArenaPushAligned(&pool->arena, pool->element_size, pool->element_align);
+    }
+    return memory;
+}
+
+internal void *
+M_PoolAllocZero(M_Pool *pool)
+{
+    void *memory = M_PoolAlloc(pool);
+    MemorySet(memory, 0, pool->element_size);
+    return memory;
+}
+
+internal void
+M_PoolFree(M_Pool *pool, void *memory)
+{
+    if(memory)
+    {
+        M_PoolFreeNode *node = memory;
+        node->next = pool->free_list;
+        pool->free_list = node;
+    }
+}
+
+// NOTE(rjf): Frees every element at once. The backing arena is cleared, so
+// its decommit policy applies to the pool as well. Thread caches from before
+// the clear are dropped on their next use.
+internal void
+M_PoolClear(M_Pool *pool)
+{
+    pool->free_list = 0;
+    pool->generation += 1;
+    M_ArenaClear(&pool->arena);
+}
+
+#define M_PoolAllocType(pool, T)     ((T *)M_PoolAlloc(pool))
+#define M_PoolAllocTypeZero(pool, T) ((T *)M_PoolAllocZero(pool))
+
+//~ NOTE(rjf): Thread-Cached Pool Access
+
+internal void
+M_PoolLock(M_Pool *pool)
+{
+    while(AtomicCompareExchangeU32(&pool->lock, 1, 0) != 0)
+    {
+        SpinPause();
+    }
+}
+
+internal void
+M_PoolUnlock(M_Pool *pool)
+{
+    AtomicStoreU32(&pool->lock, 0);
+}
+
+internal void *
+M_PoolCacheAlloc(M_Pool *pool, M_PoolCache *cache)
+{
+    if(cache->generation != pool->generation)
+    {
+        cache->generation = pool->generation;
+        cache->free_list = 0;
+        cache->count = 0;
+    }
+    
+    if(!cache->free_list)
+    {
+        // NOTE(rjf): Refill a whole batch under one lock, carving new
+        // elements from the arena when the shared free list runs dry.
+        M_PoolLock(pool);
+        for(u32 i = 0; i < M_POOL_CACHE_BATCH; ++i)
+        {
+            M_PoolFreeNode *node = (M_PoolFreeNode *)M_PoolAlloc(pool);
+            node->next = cache->free_list;
+            cache->free_list = node;
+        }
+        M_PoolUnlock(pool);
+        cache->count = M_POOL_CACHE_BATCH;
+    }
+    
+    M_PoolFreeNode *node = cache->free_list;
+    cache->free_list = node->next;
+    cache->count -= 1;
+    return node;
+}
+
+internal void
+M_PoolCacheFree(M_Pool *pool, M_PoolCache *cache, void *memory)
+{
+    // NOTE(rjf): Nodes cached before an M_PoolClear point into memory the
+    // pool is carving again, so they must never reach the shared list.
+    if(cache->generation != pool->generation)
+    {
+        cache->generation = pool->generation;
+        cache->free_list = 0;
+        cache->count = 0;
+    }
+
+    if(memory)
+    {
+        M_PoolFreeNode *node = memory;
+        node->next = cache->free_list;
+        cache->free_list = node;
+        cache->count += 1;
+        
+        // NOTE(rjf): Hand a batch back once the cache is full, so one
+        // thread freeing what another allocated can't hoard the pool.
+        if(cache->count >= M_POOL_CACHE_CAPACITY)
+        {
+            M_PoolFreeNode *first = cache->free_list;
+            M_PoolFreeNode *last = first;
+            for(u32 i = 1; i < M_POOL_CACHE_BATCH; ++i)
+            {
+                last = last->next;
+            }
+            cache->free_list = last->next;
+            cache->count -= M_POOL_CACHE_BATCH;
+            
+            M_PoolLock(pool);
+            last->next = pool->free_list;
+            pool->free_list = first;
+            M_PoolUnlock(pool);
+        }
+    }
+}
+
+// NOTE(rjf): Returns every cached element to the pool; call before a thread
+// that used the cache goes away.
+internal void
+M_PoolCacheFlush(M_Pool *pool, M_PoolCache *cache)
+{
+    if(cache->free_list && cache->generation == pool->generation)
+    {
+        M_PoolFreeNode *last = cache->free_list;
+        for(; last->next; last = last->next);
+        M_PoolLock(pool);
+        last->next = pool->free_list;
+        pool->free_list = cache->free_list;
+        M_PoolUnlock(pool);
+    }
+    cache->free_list = 0;
+    cache->count = 0;
+}
+
+//~ NOTE(rjf): Slot Maps
+
+#define M_SlotHandleIndex(handle)      ((u32)((handle) & 0xffffffff))
+#define M_SlotHandleGeneration(handle) ((u32)((handle) >> 32))
+#define M_SlotHandleMake(index, generation) ((((u64)(generation)) << 32) | (u64)(index))
+
+internal M_SlotMap
+M_SlotMapInitialize(u64 value_size, u32 max_count)
+{
+    M_SlotMap map = {0};
+    map.value_size = value_size;
+    map.max_count = max_count;
+    
+    M_ArenaParams params = M_ArenaDefaultParams();
+    params.decommit_clear_count = 0;
+    
+    params.reserve_size = AlignPow2(value_size*max_count, M_ARENA_COMMIT_SIZE);
+    map.value_arena = M_ArenaInitializeWithParams(&params);
+    params.reserve_size = AlignPow2(sizeof(u32)*max_count, M_ARENA_COMMIT_SIZE);
+    map.value_slot_arena = M_ArenaInitializeWithParams(&params);
+    params.reserve_size = AlignPow2(sizeof(M_SlotMapSlot)*max_count, M_ARENA_COMMIT_SIZE);
+    map.slot_arena = M_ArenaInitializeWithParams(&params);
+    
+    map.values = map.value_arena.base;
+    map.value_slots = map.value_slot_arena.base;
+    map.slots = map.slot_arena.base;
+    return map;
+}
+
+#define M_SlotMapInitializeForType(T, max_count) M_SlotMapInitialize(AlignPow2(sizeof(T), M_TypeAlign(T)), (max_count))
+
+internal void
+M_SlotMapRelease(M_SlotMap *map)
+{
+    M_ArenaRelease(&map->value_arena);
+    M_ArenaRelease(&map->value_slot_arena);
+    M_ArenaRelease(&map->slot_arena);
+    MemorySet(map, 0, sizeof(*map));
+}
+
+// NOTE(rjf): Returns zeroed storage for the new value, or 0 if the map is
+// full.
+internal void *
+M_SlotMapInsert(M_SlotMap *map, M_SlotHandle *handle_out)
+{
+    void *value = 0;
+    *handle_out = 0;
+    
+    u32 slot_index = 0;
+    if(map->first_free_slot)
+    {
+        slot_index = map->first_free_slot - 1;
+        map->first_free_slot = map->slots[slot_index].index;
+    }
+    else if(map->slot_count < map->max_count)
+    {
+        slot_index = map->slot_count++;
+        M_ArenaPushZero(&map->slot_arena, sizeof(M_SlotMapSlot));
+    }
+    else
+    {
+        goto end;
+    }
+    
+    M_SlotMapSlot *slot = map->slots + slot_index;
+    slot->generation += 1;
+    slot->index = map->count++;
+    value = M_ArenaPushZero(&map->value_arena, map->value_size);
+    *(u32 *)M_ArenaPush(&map->value_slot_arena, sizeof(u32)) = slot_index;
+    *handle_out = M_SlotHandleMake(slot_index, slot->generation);
+    
+    end:;
+    return value;
+}
+
+internal void *
+M_SlotMapLookup(M_SlotMap *map, M_SlotHandle handle)
+{
+    void *value = 0;
+    u32 slot_index = M_SlotHandleIndex(handle);
+    if(slot_index < map->slot_count)
+    {
+        M_SlotMapSlot *slot = map->slots + slot_index;
+        if(slot->generation == M_SlotHandleGeneration(handle) && (slot->generation & 1))
+        {
+            value = map->values + slot->index*map->value_size;
+        }
+    }
+    return value;
+}
+
+internal b32
+M_SlotMapRemove(M_SlotMap *map, M_SlotHandle handle)
+{
+    b32 result = 0;
+    if(M_SlotMapLookup(map, handle))
+    {
+        u32 slot_index = M_SlotHandleIndex(handle);
+        M_SlotMapSlot *slot = map->slots + slot_index;
+        
+        // NOTE(rjf): Move the last value into the hole to keep values dense.
+        u32 last = map->count-1;
+        if(slot->index != last)
+        {
+            MemoryCopy(map->values + slot->index*map->value_size,
+                       map->values + last*map->value_size,
+                       map->value_size);
+            map->value_slots[slot->index] = map->value_slots[last];
+            map->slots[map->value_slots[last]].index = slot->index;
+        }
+        map->count -= 1;
+        M_ArenaPop(&map->value_arena, map->value_size);
+        M_ArenaPop(&map->value_slot_arena, sizeof(u32));
+        
+        slot->generation += 1;
+        slot->index = map->first_free_slot;
+        map->first_free_slot = slot_index + 1;
+        result = 1;
+    }
+    return result;
+}
+
+// NOTE(rjf): Dense iteration: for(u32 i = 0; i < map->count; ++i) uses
+// M_SlotMapValueAt(map, i), and M_SlotMapHandleAt(map, i) recovers its
+// handle.
+internal void *
+M_SlotMapValueAt(M_SlotMap *map, u32 index)
+{
+    return map->values + index*map->value_size;
+}
+
+internal M_SlotHandle
+M_SlotMapHandleAt(M_SlotMap *map, u32 index)
+{
+    u32 slot_index = map->value_slots[index];
+    return M_SlotHandleMake(slot_index, map->slots[slot_index].generation);
+}
+
+#define M_SlotMapLookupType(map, handle, T) ((T *)M_SlotMapLookup((map), (handle)))
+#define M_SlotMapValueAtType(map, index, T) ((T *)M_SlotMapValueAt((map), (index)))
+
+//~ NOTE(rjf): Growable Arrays
+
+#define M_ARRAY_MIN_CAPACITY 16
+
+internal M_Array
+M_ArrayInitialize(M_Arena *arena, u64 element_size, u64 element_align, u64 initial_capacity)
+{
+    M_Array array = {0};
+    array.arena = arena;
+    array.element_size = element_size;
+    array.element_align = element_align;
+    if(initial_capacity)
+    {
+        array.data = M_ArenaPushAligned(arena, element_size*initial_capacity, element_align);
+        array.capacity = initial_capacity;
+    }
+    return array;
+}
+
+#define M_ArrayInitializeForType(arena, T, initial_capacity) M_ArrayInitialize((arena), sizeof(T), M_TypeAlign(T), (initial_capacity))
+
+internal b32
+M_ArrayIsArenaTop(M_Array *array)
+{
+    M_Arena *arena = array->arena;
+    return (array->data &&
+            array->data + array->capacity*array->element_size == (u8 *)arena->base + arena->alloc_position);
+}
+
+internal void
+M_ArrayReserve(M_Array *array, u64 capacity)
+{
+    if(capacity > array->capacity)
+    {
+        u64 new_capacity = Max(capacity, array->capacity*2);
+        new_capacity = Max(new_capacity, M_ARRAY_MIN_CAPACITY);
+        
+        if(M_ArrayIsArenaTop(array) &&
+           array->arena->alloc_position + (new_capacity - array->capacity)*array->element_size <= array->arena->max)
+        {
+            // NOTE(rjf): Nothing has been pushed since; extend in place.
+            M_ArenaPush(array->arena, (new_capacity - array->capacity)*array->element_size);
+        }
+        else
+        {
+            u8 *data = M_ArenaPushAligned(array->arena, new_capacity*array->element_size, array->element_align);
+            if(array->count)
+            {
+                MemoryCopy(data, array->data, array->count*array->element_size);
+            }
+            array->data = data;
+        }
+        array->capacity = new_capacity;
+    }
+}
+
+// NOTE(rjf): Returns storage for count new elements at the end of the array.
+// The pointer is only good until the next push, since growing may move the
+// array.
+internal void *
+M_ArrayPushN(M_Array *array, u64 count)
+{
+    M_ArrayReserve(array, array->count + count);
+    void *result = array->data + array->count*array->element_size;
+    array->count += count;
+    return result;
+}
+
+internal void *
+M_ArrayPush(M_Array *array)
+{
+    return M_ArrayPushN(array, 1);
+}
+
+internal void *
+M_ArrayPushZero(M_Array *array)
+{
+    void *result = M_ArrayPushN(array, 1);
+    MemorySet(result, 0, array->element_size);
+    return result;
+}
+
+internal void
+M_ArrayAppend(M_Array *array, void *elements, u64 count)
+{
+    if(count)
+    {
+        MemoryCopy(M_ArrayPushN(array, count), elements, count*array->element_size);
+    }
+}
+
+internal void
+M_ArrayPop(M_Array *array, u64 count)
+{
+    array->count -= Min(count, array->count);
+}
+
+internal void
+M_ArrayClear(M_Array *array)
+{
+    array->count = 0;
+}
+
+// NOTE(rjf): Hands the unused capacity back to the arena. This only works
+// while the array is still on top of the arena; otherwise the slack stays
+// where it is.
+internal void
+M_ArrayShrinkToFit(M_Array *array)
+{
+    if(M_ArrayIsArenaTop(array))
+    {
+        M_ArenaPop(array->arena, (array->capacity - array->count)*array->element_size);
+        array->capacity = array->count;
+        if(!array->capacity)
+        {
+            array->data = 0;
+        }
+    }
+}
+
+#define M_ArrayPushType(array, T)       ((T *)M_ArrayPush(array))
+#define M_ArrayPushTypeZero(array, T)   ((T *)M_ArrayPushZero(array))
+#define M_ArrayAt(array, T, index)      (((T *)(array)->data)[index])
+
+//~ NOTE(rjf): Ring Buffers
+
+// NOTE(rjf): Views can only be mapped at allocation-granularity boundaries
+// (64K on Windows), so capacities are rounded up to it.
+#define M_RING_BUFFER_GRANULARITY Kilobytes(64)
+
+internal M_RingBuffer
+M_RingBufferInitialize(u64 capacity)
+{
+    M_RingBuffer ring = {0};
+    capacity = AlignPow2(Max(capacity, 1), M_RING_BUFFER_GRANULARITY);
+    ring.base = os->ReserveRing(capacity);
+    if(ring.base)
+    {
+        ring.capacity = capacity;
+    }
+    return ring;
+}
+
+internal void
+M_RingBufferRelease(M_RingBuffer *ring)
+{
+    if(ring->base)
+    {
+        os->ReleaseRing(ring->base, ring->capacity);
+    }
+    MemorySet(ring, 0, sizeof(*ring));
+}
+
+// NOTE(rjf): Producer side. Writes go to M_RingBufferWritePointer, and become
+// visible to the consumer once M_RingBufferCommitWrite publishes them. The
+// consumer's position is only reloaded when the cached one doesn't leave
+// room for wanted bytes, so the producer rarely reads its cache line.
+internal u64
+M_RingBufferWriteAvailable(M_RingBuffer *ring, u64 wanted)
+{
+    u64 available = ring->capacity - (ring->write_position - ring->cached_read_position);
+    if(available < wanted)
+    {
+        ring->cached_read_position = AtomicLoadU64(&ring->read_position);
+        available = ring->capacity - (ring->write_position - ring->cached_read_position);
+    }
+    return available;
+}
+
+internal u8 *
+M_RingBufferWritePointer(M_RingBuffer *ring)
+{
+    return ring->base + ring->write_position % ring->capacity;
+}
+
+internal void
+M_RingBufferCommitWrite(M_RingBuffer *ring, u64 size)
+{
+    AtomicStoreU64(&ring->write_position, ring->write_position + size);
+}
+
+// NOTE(rjf): Writes all of data or nothing.
+internal b32
+M_RingBufferWrite(M_RingBuffer *ring, void *data, u64 size)
+{
+    b32 result = 0;
+    if(M_RingBufferWriteAvailable(ring, size) >= size)
+    {
+        MemoryCopy(M_RingBufferWritePointer(ring), data, size);
+        M_RingBufferCommitWrite(ring, size);
+        result = 1;
+    }
+    return result;
+}
+
+// NOTE(rjf): Consumer side, mirroring the producer.
+internal u64
+M_RingBufferReadAvailable(M_RingBuffer *ring)
+{
+    u64 available = ring->cached_write_position - ring->read_position;
+    if(available == 0)
+    {
+        ring->cached_write_position = AtomicLoadU64(&ring->write_position);
+        available = ring->cached_write_position - ring->read_position;
+    }
+    return available;
+}
+
+internal u8 *
+M_RingBufferReadPointer(M_RingBuffer *ring)
+{
+    return ring->base + ring->read_position % ring->capacity;
+}
+
+internal void
+M_RingBufferCommitRead(M_RingBuffer *ring, u64 size)
+{
+    AtomicStoreU64(&ring->read_position, ring->read_position + size);
+}
+
+// NOTE(rjf): Reads up to size bytes; returns how many were read.
+internal u64
+M_RingBufferRead(M_RingBuffer *ring, void *data, u64 size)
+{
+    u64 available = M_RingBufferReadAvailable(ring);
+    if(size > available)
+    {
+        size = available;
+    }
+    MemoryCopy(data, M_RingBufferReadPointer(ring), size);
+    M_RingBufferCommitRead(ring, size);
+    return size;
+}
+
+//~ NOTE(rjf): TLSF Heap
+
+#define M_HEAP_BLOCK_FREE         (1<<0)
+#define M_HEAP_BLOCK_PREV_FREE    (1<<1)
+#define M_HEAP_BLOCK_HEADER_SIZE  (2*sizeof(u64))
+#define M_HEAP_BLOCK_MIN_SIZE     (2*sizeof(void *))
+#define M_HEAP_BLOCK_MAX_SIZE     (((u64)1 << M_HEAP_FL_MAX) - 1)
+#define M_HEAP_COMMIT_CHUNK_SIZE  Kilobytes(256)
+
+internal u64
+M_HeapBlockSize(M_HeapBlock *block)
+{
+    return block->size & ~(u64)(M_HEAP_BLOCK_FREE | M_HEAP_BLOCK_PREV_FREE);
+}
+
+internal void
+M_HeapBlockSetSize(M_HeapBlock *block, u64 size)
+{
+    block->size = size | (block->size & (M_HEAP_BLOCK_FREE | M_HEAP_BLOCK_PREV_FREE));
+}
+
+internal M_HeapBlock *
+M_HeapBlockNext(M_HeapBlock *block)
+{
+    return (M_HeapBlock *)((u8 *)block + M_HEAP_BLOCK_HEADER_SIZE + M_HeapBlockSize(block));
+}
+
+internal void *
+M_HeapBlockPayload(M_HeapBlock *block)
+{
+    return (u8 *)block + M_HEAP_BLOCK_HEADER_SIZE;
+}
+
+internal M_HeapBlock *
+M_HeapBlockFromPayload(void *payload)
+{
+    return (M_HeapBlock *)((u8 *)payload - M_HEAP_BLOCK_HEADER_SIZE);
+}
+
+internal void
+M_HeapBlockMarkFree(M_HeapBlock *block)
+{
+    M_HeapBlock *next = M_HeapBlockNext(block);
+    block->size |= M_HEAP_BLOCK_FREE;
+    next->prev_physical = block;
+    next->size |= M_HEAP_BLOCK_PREV_FREE;
+}
+
+internal void
+M_HeapBlockMarkUsed(M_HeapBlock *block)
+{
+    M_HeapBlock *next = M_HeapBlockNext(block);
+    block->size &= ~(u64)M_HEAP_BLOCK_FREE;
+    next->size &= ~(u64)M_HEAP_BLOCK_PREV_FREE;
+}
+
+internal void
+M_HeapMapping(u64 size, u32 *fl_out, u32 *sl_out)
+{
+    u32 fl = 0;
+    u32 sl = 0;
+    if(size < M_HEAP_SMALL_BLOCK_SIZE)
+    {
+        sl = (u32)(size / (M_HEAP_SMALL_BLOCK_SIZE / M_HEAP_SL_COUNT));
+    }
+    else
+    {
+        u32 bit = HighestSetBitU64(size);
+        sl = (u32)(size >> (bit - M_HEAP_SL_COUNT_LOG2)) ^ M_HEAP_SL_COUNT;
+        fl = bit - (M_HEAP_FL_SHIFT - 1);
+    }
+    *fl_out = fl;
+    *sl_out = sl;
+}
+
+internal void
+M_HeapInsertFreeBlock(M_Heap *heap, M_HeapBlock *block)
+{
+    u32 fl, sl;
+    M_HeapMapping(M_HeapBlockSize(block), &fl, &sl);
+    M_HeapBlock *head = heap->free_lists[fl][sl];
+    block->next_free = head;
+    block->prev_free = 0;
+    if(head)
+    {
+        head->prev_free = block;
+    }
+    heap->free_lists[fl][sl] = block;
+    heap->fl_bitmap |= (1u << fl);
+    heap->sl_bitmaps[fl] |= (1u << sl);
+    heap->free_bytes += M_HeapBlockSize(block);
+    heap->free_block_count += 1;
+}
+
+internal void
+M_HeapRemoveFreeBlock(M_Heap *heap, M_HeapBlock *block)
+{
+    u32 fl, sl;
+    M_HeapMapping(M_HeapBlockSize(block), &fl, &sl);
+    if(block->prev_free)
+    {
+        block->prev_free->next_free = block->next_free;
+    }
+    else
+    {
+        heap->free_lists[fl][sl] = block->next_free;
+        if(!block->next_free)
+        {
+            heap->sl_bitmaps[fl] &= ~(1u << sl);
+            if(!heap->sl_bitmaps[fl])
+            {
+                heap->fl_bitmap &= ~(1u << fl);
+            }
+        }
+    }
+    if(block->next_free)
+    {
+        block->next_free->prev_free = block->prev_free;
+    }
+    heap->free_bytes -= M_HeapBlockSize(block);
+    heap->free_block_count -= 1;
+}
+
+// NOTE(rjf): Finds a free block of at least size bytes. The size is rounded
+// up to the next sub-range first, so any block in the list found is big
+// enough and no list has to be walked.
+internal M_HeapBlock *
+M_HeapFindFreeBlock(M_Heap *heap, u64 size)
+{
+    M_HeapBlock *block = 0;
+    if(size >= M_HEAP_SMALL_BLOCK_SIZE)
+    {
+        size += ((u64)1 << (HighestSetBitU64(size) - M_HEAP_SL_COUNT_LOG2)) - 1;
+    }
+    u32 fl, sl;
+    M_HeapMapping(size, &fl, &sl);
+    if(fl < M_HEAP_FL_COUNT)
+    {
+        u32 sl_map = heap->sl_bitmaps[fl] & (~0u << sl);
+        if(!sl_map)
+        {
+            u32 fl_map = fl+1 < 32 ? heap->fl_bitmap & (~0u << (fl+1)) : 0;
+            if(fl_map)
+            {
+                fl = LowestSetBitU32(fl_map);
+                sl_map = heap->sl_bitmaps[fl];
+            }
+        }
+        if(sl_map)
+        {
+            sl = LowestSetBitU32(sl_map);
+            block = heap->free_lists[fl][sl];
+        }
+    }
+    return block;
+}
+
+// NOTE(rjf): Merges a block that is about to become free with its free
+// physical neighbours, and puts the result on the free lists.
+internal void
+M_HeapReleaseBlock(M_Heap *heap, M_HeapBlock *block)
+{
+    if(block->size & M_HEAP_BLOCK_PREV_FREE)
+    {
+        M_HeapBlock *prev = block->prev_physical;
+        M_HeapRemoveFreeBlock(heap, prev);
+        M_HeapBlockSetSize(prev, M_HeapBlockSize(prev) + M_HEAP_BLOCK_HEADER_SIZE + M_HeapBlockSize(block));
+        block = prev;
+    }
+    M_HeapBlock *next = M_HeapBlockNext(block);
+    if(next->size & M_HEAP_BLOCK_FREE)
+    {
+        M_HeapRemoveFreeBlock(heap, next);
+        M_HeapBlockSetSize(block, M_HeapBlockSize(block) + M_HEAP_BLOCK_HEADER_SIZE + M_HeapBlockSize(next));
+    }
+    M_HeapBlockMarkFree(block);
+    M_HeapInsertFreeBlock(heap, block);
+}
+
+// NOTE(rjf): Shrinks a block to size, returning the remainder to the free
+// lists (merged with a free successor) if it is big enough to be a block of
+// its own.
+internal void
+M_HeapTrimBlock(M_Heap *heap, M_HeapBlock *block, u64 size)
+{
+    u64 block_size = M_HeapBlockSize(block);
+    if(block_size >= size + M_HEAP_BLOCK_HEADER_SIZE + M_HEAP_BLOCK_MIN_SIZE)
+    {
+        M_HeapBlock *remainder = (M_HeapBlock *)((u8 *)M_HeapBlockPayload(block) + size);
+        remainder->size = block_size - size - M_HEAP_BLOCK_HEADER_SIZE;
+        M_HeapBlockSetSize(block, size);
+        M_HeapReleaseBlock(heap, remainder);
+    }
+}
+
+// NOTE(rjf): Commits more memory at the top of the heap. The old sentinel
+// becomes the header of a new free block covering the fresh range, and a new
+// sentinel (a used, zero-sized block) caps the end.
+internal b32
+M_HeapGrow(M_Heap *heap, u64 size)
+{
+    b32 result = 0;
+    
+    // NOTE(rjf): Leave room for M_HeapFindFreeBlock rounding size up by one
+    // sub-range.
+    size += size >> M_HEAP_SL_COUNT_LOG2;
+    u64 grow_size = AlignPow2(size + 2*M_HEAP_BLOCK_HEADER_SIZE, heap->commit_chunk_size);
+    if(heap->commit_position + grow_size <= heap->max)
+    {
+        os->Commit(heap->base + heap->commit_position, grow_size);
+        heap->commit_position += grow_size;
+        
+        M_HeapBlock *block = heap->sentinel;
+        M_HeapBlockSetSize(block, grow_size - M_HEAP_BLOCK_HEADER_SIZE);
+        heap->sentinel = M_HeapBlockNext(block);
+        heap->sentinel->size = 0;
+        M_HeapReleaseBlock(heap, block);
+        result = 1;
+    }
+    return result;
+}
+
+internal M_Heap
+M_HeapInitialize(u64 reserve_size)
+{
+    M_Heap heap = {0};
+    heap.max = AlignPow2(reserve_size, M_ARENA_COMMIT_SIZE);
+    heap.base = os->Reserve(heap.max);
+    heap.commit_chunk_size = M_HEAP_COMMIT_CHUNK_SIZE;
+    return heap;
+}
+
+internal void
+M_HeapRelease(M_Heap *heap)
+{
+    os->Release(heap->base);
+    MemorySet(heap, 0, sizeof(*heap));
+}
+
+internal void *
+M_HeapAlloc(M_Heap *heap, u64 size)
+{
+    void *memory = 0;
+    
+    // NOTE(rjf): Lazily commit the first chunk, so a zero-initialized heap
+    // in a struct costs nothing until it's used.
+    if(!heap->sentinel && heap->base)
+    {
+        os->Commit(heap->base, heap->commit_chunk_size);
+        heap->commit_position = heap->commit_chunk_size;
+        M_HeapBlock *block = (M_HeapBlock *)heap->base;
+        block->size = heap->commit_chunk_size - 2*M_HEAP_BLOCK_HEADER_SIZE;
+        heap->sentinel = M_HeapBlockNext(block);
+        heap->sentinel->size = 0;
+        M_HeapBlockMarkFree(block);
+        M_HeapInsertFreeBlock(heap, block);
+    }
+    
+    if(size && size <= M_HEAP_BLOCK_MAX_SIZE && heap->sentinel)
+    {
+        size = Max(AlignPow2(size, M_HEAP_ALIGN), M_HEAP_BLOCK_MIN_SIZE);
+        M_HeapBlock *block = M_HeapFindFreeBlock(heap, size);
+        if(!block && M_HeapGrow(heap, size))
+        {
+            block = M_HeapFindFreeBlock(heap, size);
+        }
+        if(block)
+        {
+            M_HeapRemoveFreeBlock(heap, block);
+            M_HeapTrimBlock(heap, block, size);
+            M_HeapBlockMarkUsed(block);
+            heap->used_bytes += M_HeapBlockSize(block);
+            heap->used_block_count += 1;
+            memory = M_HeapBlockPayload(block);
+        }
+    }
+    return memory;
+}
+
+internal void
+M_HeapFree(M_Heap *heap, void *memory)
+{
+    if(memory)
+    {
+        M_HeapBlock *block = M_HeapBlockFromPayload(memory);
+        heap->used_bytes -= M_HeapBlockSize(block);
+        heap->used_block_count -= 1;
+        M_HeapReleaseBlock(heap, block);
+    }
+}
+
+internal void *
+M_HeapRealloc(M_Heap *heap, void *memory, u64 size)
+{
+    void *result = 0;
+    if(!memory)
+    {
+        result = M_HeapAlloc(heap, size);
+    }
+    else if(!size)
+    {
+        M_HeapFree(heap, memory);
+    }
+    else
+    {
+        M_HeapBlock *block = M_HeapBlockFromPayload(memory);
+        u64 old_size = M_HeapBlockSize(block);
+        u64 new_size = Max(AlignPow2(size, M_HEAP_ALIGN), M_HEAP_BLOCK_MIN_SIZE);
+        M_HeapBlock *next = M_HeapBlockNext(block);
+        
+        // NOTE(rjf): Grow in place into a free neighbour when possible.
+        if(new_size > old_size && (next->size & M_HEAP_BLOCK_FREE) &&
+           old_size + M_HEAP_BLOCK_HEADER_SIZE + M_HeapBlockSize(next) >= new_size)
+        {
+            M_HeapRemoveFreeBlock(heap, next);
+            M_HeapBlockSetSize(block, old_size + M_HEAP_BLOCK_HEADER_SIZE + M_HeapBlockSize(next));
+            M_HeapBlockMarkUsed(block);
+        }
+        
+        if(M_HeapBlockSize(block) >= new_size)
+        {
+            M_HeapTrimBlock(heap, block, new_size);
+            heap->used_bytes += M_HeapBlockSize(block);
+            heap->used_bytes -= old_size;
+            result = memory;
+        }
+        else
+        {
+            result = M_HeapAlloc(heap, size);
+            if(result)
+            {
+                MemoryCopy(result, memory, old_size);
+                M_HeapFree(heap, memory);
+            }
+        }
+    }
+    return result;
+}
+
+internal M_HeapStats
+M_HeapGetStats(M_Heap *heap)
+{
+    M_HeapStats stats = {0};
+    stats.reserved_bytes = heap->max;
+    stats.committed_bytes = heap->commit_position;
+    stats.used_bytes = heap->used_bytes;
+    stats.used_block_count = heap->used_block_count;
+    stats.free_bytes = heap->free_bytes;
+    stats.free_block_count = heap->free_block_count;
+    
+    // NOTE(rjf): The largest free block is in the highest non-empty list.
+    if(heap->fl_bitmap)
+    {
+        u32 fl = HighestSetBitU32(heap->fl_bitmap);
+        u32 sl = HighestSetBitU32(heap->sl_bitmaps[fl]);
+        for(M_HeapBlock *block = heap->free_lists[fl][sl]; block; block = block->next_free)
+        {
+            stats.largest_free_block = Max(stats.largest_free_block, M_HeapBlockSize(block));
+        }
+    }
+    if(stats.free_bytes)
+    {
+        stats.fragmentation = 1.f - (f32)stats.largest_free_block / (f32)stats.free_bytes;
+    }
+    return stats;
+}
+
+// NOTE(rjf): To route ext/stb_image.h through the process heap, define these
+// before including it:
+//
+//   #define STBI_MALLOC(size)          M_HeapAlloc(&os->heap, (size))
+//   #define STBI_REALLOC(memory, size) M_HeapRealloc(&os->heap, (memory), (size))
+//   #define STBI_FREE(memory)          M_HeapFree(&os->heap, (memory))
+
+//~ NOTE(rjf): Arena Snapshots
+
+// NOTE(rjf): Base-relative pointers survive a snapshot being restored at a
+// different address. Offsets are stored plus one, so 0 stays null.
+#define M_ArenaOffsetFromPointer(arena, pointer) ((pointer) ? (u64)((u8 *)(pointer) - (u8 *)(arena)->base) + 1 : 0)
+#define M_ArenaPointerFromOffset(arena, offset)  ((offset) ? (void *)((u8 *)(arena)->base + (offset) - 1) : 0)
+
+internal void
+M_ArenaSaveSnapshot(M_Arena *arena, String8 path, u64 user_version)
+{
+    M_ArenaSnapshotHeader header = {0};
+    header.magic = M_ARENA_SNAPSHOT_MAGIC;
+    header.version = M_ARENA_SNAPSHOT_VERSION;
+    header.header_size = sizeof(header);
+    header.user_version = user_version;
+    header.base_address = (u64)arena->base;
+    header.reserve_size = arena->max;
+    header.used_size = arena->alloc_position;
+    os->SaveToFile(path, &header, sizeof(header));
+    os->AppendToFile(path, arena->base, arena->alloc_position);
+}
+
+// NOTE(rjf): Replaces arena with the contents of the snapshot at path, keeping
+// arena's commit/decommit policy. The snapshot is read straight into a fresh
+// reservation at its old base address if the OS still has that range free,
+// or anywhere otherwise. On failure arena keeps its contents.
+internal M_ArenaSnapshotLoad
+M_ArenaLoadSnapshot(M_Arena *arena, String8 path, u64 user_version)
+{
+    M_ArenaSnapshotLoad result = {0};
+    M_ArenaSnapshotHeader header = {0};
+    if(os->ReadFromFile(path, 0, &header, sizeof(header)) == sizeof(header) &&
+       header.magic == M_ARENA_SNAPSHOT_MAGIC &&
+       header.version == M_ARENA_SNAPSHOT_VERSION &&
+       header.header_size == sizeof(header) &&
+       header.user_version == user_version &&
+       header.used_size <= header.reserve_size)
+    {
+        // NOTE(rjf): An arena reserved at startup can easily land on the
+        // range the snapshot came from, since the address space tends to be
+        // laid out the same way from run to run. Nothing in an empty arena
+        // is lost by handing its range back first; if the load then fails,
+        // it just gets a new reservation.
+        b32 released_empty_arena = 0;
+        if(arena->base && arena->alloc_position == 0 && !(arena->flags & M_ArenaFlag_LargePages))
+        {
+            M_ArenaRelease(arena);
+            arena->base = 0;
+            released_empty_arena = 1;
+        }
+        
+        u8 *base = os->ReserveAt((void *)header.base_address, header.reserve_size);
+        if(!base)
+        {
+            base = os->Reserve(header.reserve_size);
+        }
+        
+        if(base)
+        {
+            u64 commit_size = header.used_size + arena->commit_chunk_size-1;
+            commit_size -= commit_size % arena->commit_chunk_size;
+            commit_size = Min(commit_size, header.reserve_size);
+            if(commit_size)
+            {
+                os->Commit(base, commit_size);
+            }
+            if(os->ReadFromFile(path, header.header_size, base, header.used_size) == header.used_size)
+            {
+                M_Arena restored = *arena;
+                restored.base = base;
+                restored.max = header.reserve_size;
+                restored.alloc_position = header.used_size;
+                restored.commit_position = commit_size;
+                restored.zero_position = header.used_size;
+                restored.clear_peak_position = header.used_size;
+                restored.flags &= ~M_ArenaFlag_LargePages;
+                if(arena->base)
+                {
+                    M_ArenaRelease(arena);
+                }
+                *arena = restored;
+                
+                result.loaded = 1;
+                result.relocation = (i64)((u64)base - header.base_address);
+                result.relocated = result.relocation != 0;
+            }
+            else
+            {
+                os->Release(base);
+            }
+        }
+        
+        if(released_empty_arena && !result.loaded)
+        {
+            arena->base = os->Reserve(arena->max);
+            arena->commit_position = 0;
+            arena->zero_position = 0;
+        }
+    }
+    return result;
+}
+
+//~ NOTE(rjf): Arena Instrumentation
+
+#if M_ARENA_INSTRUMENT
+
+// NOTE(rjf): Every file included after this one pushes through these
+// wrappers, so pushes are tagged with the callsite of the outermost call.
+// The code in this file calls the functions directly, so the tag survives
+// nested pushes (e.g. M_PushArray -> M_ArenaPushAligned -> M_ArenaPush).
+#define M_ArenaPush(arena, size)                   (M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPush((arena), (size)))
+#define M_ArenaPushZero(arena, size)               (M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPushZero((arena), (size)))
+#define M_ArenaPushAligned(arena, size, align)     (M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPushAligned((arena), (size), (align)))
+#define M_ArenaPushZeroAligned(arena, size, align) (M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPushZeroAligned((arena), (size), (align)))
+#define M_ArenaPushCacheAligned(arena, size)       (M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPushCacheAligned((arena), (size)))
+#define M_ArenaPushSoA(arena, count, array_count, element_sizes, arrays, align) \
+(M_ArenaSetCallsite(__FILE__, __LINE__), M_ArenaPushSoA((arena), (count), (array_count), (element_sizes), (arrays), (align)))
+
+internal void
+M_ArenaReportAppend(M_Arena *out, char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char buffer[512];
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if(length > 0)
+    {
+        length = Min(length, (int)sizeof(buffer)-1);
+        MemoryCopy(M_ArenaPush(out, length), buffer, length);
+    }
+}
+
+// NOTE(rjf): Appends a plain-text report for each arena to out. Callsites
+// are listed biggest first. Returns the report's first byte; the report runs
+// to out's alloc_position.
+internal u8 *
+M_ArenaWriteReport(M_Arena *out, M_Arena **arenas, u32 arena_count)
+{
+    u8 *start = (u8 *)out->base + out->alloc_position;
+    for(u32 arena_index = 0; arena_index < arena_count; ++arena_index)
+    {
+        M_Arena *arena = arenas[arena_index];
+        M_ArenaReportAppend(out, "arena \"%s\": position %llu, peak %llu, committed %llu, reserved %llu\n",
+                            arena->name ? arena->name : "(unnamed)",
+                            arena->alloc_position, arena->peak_position,
+                            arena->commit_position, arena->max);
+        
+        // NOTE(rjf): Selection sort on a copy; there are at most a few
+        // hundred callsites and this only runs when a report is asked for.
+        M_ArenaCallsite sorted[M_ARENA_CALLSITE_MAX];
+        MemoryCopy(sorted, arena->callsites, sizeof(sorted));
+        for(u32 i = 0; i < M_ARENA_CALLSITE_MAX; ++i)
+        {
+            u32 biggest = i;
+            for(u32 j = i+1; j < M_ARENA_CALLSITE_MAX; ++j)
+            {
+                if(sorted[j].bytes > sorted[biggest].bytes)
+                {
+                    biggest = j;
+                }
+            }
+            M_ArenaCallsite swap = sorted[i];
+            sorted[i] = sorted[biggest];
+            sorted[biggest] = swap;
+            if(!sorted[i].file)
+            {
+                break;
+            }
+            M_ArenaReportAppend(out, "    %12llu bytes %8u pushes  %s:%u\n",
+                                sorted[i].bytes, sorted[i].push_count, sorted[i].file, sorted[i].line);
+        }
+        if(arena->untracked_bytes)
+        {
+            M_ArenaReportAppend(out, "    %12llu bytes (untracked)\n", arena->untracked_bytes);
+        }
+    }
+    return start;
+}
+
+// NOTE(rjf): Writes a report of the given arenas to path; meant to be called
+// once per frame (before the frame arena is cleared) from the app.
+internal void
+M_ArenaDumpReport(String8 path, M_Arena **arenas, u32 arena_count)
+{
+    M_Temp scratch = M_GetScratch(arenas, arena_count);
+    u8 *report = M_ArenaWriteReport(scratch.arena, arenas, arena_count);
+    u64 report_size = ((u8 *)scratch.arena->base + scratch.arena->alloc_position) - report;
+    os->SaveToFile(path, report, report_size);
+    M_ReleaseScratch(scratch);
+}
+
+#endif
@@ -1,4 +1,46 @@
 
+#define M_ARENA_CLEAR_HISTORY_MAX 32
+
+// NOTE(rjf): Build with -DM_ARENA_INSTRUMENT=1 to track names, peaks and
+// per-callsite push totals for every arena. With it off, none of the fields
+// or bookkeeping exist.
+#ifndef M_ARENA_INSTRUMENT
+#define M_ARENA_INSTRUMENT 0
+#endif
+#define M_ARENA_CALLSITE_MAX 128
+
+typedef struct M_ArenaCallsite M_ArenaCallsite;
+struct M_ArenaCallsite
+{
+    char *file;
+    u32 line;
+    u32 push_count;
+    u64 bytes;
+};
+
+typedef u32 M_ArenaFlags;
+enum
+{
+    // NOTE(rjf): Back the arena with large pages when the OS grants them. The
+    // whole reserve is committed (and pinned) up front, so keep reserve_size
+    // small for these arenas.
+    M_ArenaFlag_LargePages = (1<<0),
+    
+    // NOTE(rjf): Touch every page as soon as it is committed, so the page
+    // faults happen at commit time instead of on first use.
+    M_ArenaFlag_Prefault   = (1<<1),
+};
+
+typedef struct M_ArenaParams M_ArenaParams;
+struct M_ArenaParams
+{
+    M_ArenaFlags flags;
+    u64 reserve_size;
+    u64 commit_chunk_size;
+    f32 commit_growth;
+    u32 decommit_clear_count;
+};
+
 typedef struct M_Arena M_Arena;
 struct M_Arena
 {
@@ -6,4 +48,279 @@ struct M_Arena
     u64 max;
     u64 alloc_position;
     u64 commit_position;
+    
+    // NOTE(rjf): Commit policy. Every commit is at least commit_chunk_size
+    // bytes (and a multiple of it); with commit_growth above 1, it also grows
+    // the committed range geometrically, up to M_ARENA_COMMIT_GROWTH_MAX per
+    // commit.
+    M_ArenaFlags flags;
+    u64 commit_chunk_size;
+    f32 commit_growth;
+    
+    // NOTE(rjf): Decommit policy. Every clear records the peak alloc_position
+    // reached since the previous clear. Committed pages above the largest of
+    // the last decommit_clear_count peaks are handed back to the OS, so one
+    // spike doesn't pin memory for the rest of the process. A count of zero
+    // never decommits.
+    u32 decommit_clear_count;
+    u32 clear_peak_index;
+    u64 clear_peak_position;
+    u64 clear_peaks[M_ARENA_CLEAR_HISTORY_MAX];
+    
+    // NOTE(rjf): Everything in [zero_position, commit_position) has been
+    // committed but never handed out, so the OS guarantees it is still zero.
+    u64 zero_position;
+    
+#if M_ARENA_INSTRUMENT
+    // NOTE(rjf): Callsite totals count bytes pushed since the last clear;
+    // peak_position is over the arena's whole life.
+    char *name;
+    u64 peak_position;
+    u64 untracked_bytes;
+    M_ArenaCallsite callsites[M_ARENA_CALLSITE_MAX];
+#endif
+};
+
+typedef struct M_Temp M_Temp;
+struct M_Temp
+{
+    M_Arena *arena;
+    u64 position;
+};
+
+#define M_ARENA_POOL_CLASS_MAX       4
+#define M_ARENA_POOL_CLASS_CAPACITY  16
+
+typedef struct M_ArenaPoolClass M_ArenaPoolClass;
+struct M_ArenaPoolClass
+{
+    u64 reserve_size;
+    u64 warm_size;
+    u32 free_count;
+    M_Arena free_arenas[M_ARENA_POOL_CLASS_CAPACITY];
+};
+
+// NOTE(rjf): Keeps released arenas reserved (and warm) so they can be handed
+// out again without a reserve/release pair. Classes are sorted by
+// reserve_size; an acquire is served by the smallest class that fits.
+typedef struct M_ArenaPool M_ArenaPool;
+struct M_ArenaPool
+{
+    u32 class_count;
+    M_ArenaPoolClass classes[M_ARENA_POOL_CLASS_MAX];
+};
+
+// NOTE(rjf): A bump arena many threads can push to at once. Threads grab
+// chunk_size blocks from the shared alloc_position with one atomic add and
+// then hand out memory from their own M_ConcurrentArenaCursor, so the shared
+// counter is touched once per chunk. Committing is serialized by
+// commit_lock, and only taken when a thread crosses commit_position.
+typedef struct M_ConcurrentArena M_ConcurrentArena;
+struct M_ConcurrentArena
+{
+    void *base;
+    u64 max;
+    u64 chunk_size;
+    u64 commit_chunk_size;
+    volatile u64 generation;
+    volatile u64 alloc_position;
+    volatile u64 commit_position;
+    volatile u32 commit_lock;
+};
+
+typedef struct M_ConcurrentArenaCursor M_ConcurrentArenaCursor;
+struct M_ConcurrentArenaCursor
+{
+    u64 generation;
+    u64 position;
+    u64 end;
+};
+
+// NOTE(rjf): Fixed-size pool on top of its own arena. Freed elements go on an
+// intrusive free list, so alloc and free are O(1) and elements can have
+// independent lifetimes; M_PoolClear frees everything at once.
+typedef struct M_PoolFreeNode M_PoolFreeNode;
+struct M_PoolFreeNode
+{
+    M_PoolFreeNode *next;
+};
+
+typedef struct M_Pool M_Pool;
+struct M_Pool
+{
+    M_Arena arena;
+    u64 element_size;
+    u64 element_align;
+    u64 generation;
+    M_PoolFreeNode *free_list;
+    volatile u32 lock;
+};
+
+// NOTE(rjf): Per-thread cache of free elements, for pools shared between
+// threads. Only the cache refill/flush path takes the pool lock.
+typedef struct M_PoolCache M_PoolCache;
+struct M_PoolCache
+{
+    u64 generation;
+    u32 count;
+    M_PoolFreeNode *free_list;
+};
+
+// NOTE(rjf): Handles are (generation << 32) | slot index. A slot's generation
+// is odd while it is live and even while it is free, so 0 is never a valid
+// handle and a handle goes stale as soon as its value is removed.
+typedef u64 M_SlotHandle;
+
+typedef struct M_SlotMapSlot M_SlotMapSlot;
+struct M_SlotMapSlot
+{
+    u32 generation;
+    
+    // NOTE(rjf): Index into the dense arrays while live; index of the next
+    // free slot (plus one) while free.
+    u32 index;
+};
+
+// NOTE(rjf): Values are packed densely (values[0..count)) for cache-friendly
+// iteration, with a sparse slot table to map handles to them. Each array has
+// its own arena sized for max_count elements, so the map grows in place and
+// never relocates; removal moves the last value into the hole.
+typedef struct M_SlotMap M_SlotMap;
+struct M_SlotMap
+{
+    u64 value_size;
+    u32 max_count;
+    u32 count;
+    u32 slot_count;
+    u32 first_free_slot;
+    u8 *values;
+    u32 *value_slots;
+    M_SlotMapSlot *slots;
+    M_Arena value_arena;
+    M_Arena value_slot_arena;
+    M_Arena slot_arena;
+};
+
+// NOTE(rjf): Growable array on an arena. While the array's storage is the
+// last thing pushed on the arena, growing just bumps alloc_position; once
+// something else has been pushed on top, it moves to a new block twice the
+// size (the old block stays in the arena until the arena is cleared).
+typedef struct M_Array M_Array;
+struct M_Array
+{
+    M_Arena *arena;
+    u8 *data;
+    u64 count;
+    u64 capacity;
+    u64 element_size;
+    u64 element_align;
+};
+
+// NOTE(rjf): Byte ring buffer whose pages are mapped twice, back to back,
+// so the range [base, base + 2*capacity) wraps onto itself and any span of
+// up to capacity bytes is contiguous in memory. Positions only ever grow;
+// the offset into the buffer is position % capacity. With one producer and
+// one consumer thread it is lock-free: each side writes only its own
+// position (on its own cache line) and keeps a cached copy of the other's.
+typedef struct M_RingBuffer M_RingBuffer;
+struct M_RingBuffer
+{
+    u8 *base;
+    u64 capacity;
+    u8 pad0[48];
+    volatile u64 write_position;
+    u64 cached_read_position;
+    u8 pad1[48];
+    volatile u64 read_position;
+    u64 cached_write_position;
+    u8 pad2[48];
+};
+
+// NOTE(rjf): Two-level segregated fit heap. Blocks are binned by size into
+// M_HEAP_FL_COUNT power-of-two ranges, each split into M_HEAP_SL_COUNT linear
+// sub-ranges; two levels of bitmaps find a fitting free list with a couple of
+// bit scans, so alloc and free are O(1). Memory comes from one os->Reserve,
+// committed on demand at the top.
+#define M_HEAP_ALIGN_LOG2        4
+#define M_HEAP_ALIGN             (1 << M_HEAP_ALIGN_LOG2)
+#define M_HEAP_SL_COUNT_LOG2     5
+#define M_HEAP_SL_COUNT          (1 << M_HEAP_SL_COUNT_LOG2)
+#define M_HEAP_FL_SHIFT          (M_HEAP_SL_COUNT_LOG2 + M_HEAP_ALIGN_LOG2)
+#define M_HEAP_FL_MAX            36
+#define M_HEAP_FL_COUNT          (M_HEAP_FL_MAX - M_HEAP_FL_SHIFT + 1)
+#define M_HEAP_SMALL_BLOCK_SIZE  (1 << M_HEAP_FL_SHIFT)
+
+typedef struct M_HeapBlock M_HeapBlock;
+struct M_HeapBlock
+{
+    // NOTE(rjf): Only valid while the previous block is free.
+    M_HeapBlock *prev_physical;
+    
+    // NOTE(rjf): Payload size; bit 0 is set while this block is free, bit 1
+    // while the previous block is.
+    u64 size;
+    
+    // NOTE(rjf): Only valid while free; these overlap the payload.
+    M_HeapBlock *next_free;
+    M_HeapBlock *prev_free;
+};
+
+typedef struct M_HeapStats M_HeapStats;
+struct M_HeapStats
+{
+    u64 reserved_bytes;
+    u64 committed_bytes;
+    u64 used_bytes;
+    u64 used_block_count;
+    u64 free_bytes;
+    u64 free_block_count;
+    u64 largest_free_block;
+    
+    // NOTE(rjf): 1 - largest_free_block / free_bytes; 0 when all free memory
+    // is in one block.
+    f32 fragmentation;
+};
+
+typedef struct M_Heap M_Heap;
+struct M_Heap
+{
+    u8 *base;
+    u64 max;
+    u64 commit_position;
+    u64 commit_chunk_size;
+    M_HeapBlock *sentinel;
+    u32 fl_bitmap;
+    u32 sl_bitmaps[M_HEAP_FL_COUNT];
+    M_HeapBlock *free_lists[M_HEAP_FL_COUNT][M_HEAP_SL_COUNT];
+    u64 used_bytes;
+    u64 used_block_count;
+    u64 free_bytes;
+    u64 free_block_count;
+};
+
+#define M_ARENA_SNAPSHOT_MAGIC   0x544f4853414e4541ull
+#define M_ARENA_SNAPSHOT_VERSION 1
+
+typedef struct M_ArenaSnapshotHeader M_ArenaSnapshotHeader;
+struct M_ArenaSnapshotHeader
+{
+    u64 magic;
+    u32 version;
+    u32 header_size;
+    u64 user_version;
+    u64 base_address;
+    u64 reserve_size;
+    u64 used_size;
+};
+
+typedef struct M_ArenaSnapshotLoad M_ArenaSnapshotLoad;
+struct M_ArenaSnapshotLoad
+{
+    b32 loaded;
+    
+    // NOTE(rjf): Set when the snapshot couldn't be mapped back at its old
+    // base address. Raw pointers into the arena are then off by relocation
+    // bytes; base-relative offsets (M_ArenaOffsetFromPointer) still work.
+    b32 relocated;
+    i64 relocation;
 };
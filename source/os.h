@@ -172,6 +172,11 @@ struct OS_State
     // NOTE(rjf): Memory
     M_Arena permanent_arena;
     M_Arena frame_arena;
+    M_ArenaPool arena_pool;
+    M_Heap heap;
+    u64 large_page_size;
+    b32 permanent_arena_restored;
+    i64 permanent_arena_relocation;
     
     // NOTE(rjf): Options
     volatile b32 quit;
@@ -198,9 +203,16 @@ struct OS_State
     void (*Release)(void *memory);
     void (*Commit)(void *memory, u64 size);
     void (*Decommit)(void *memory, u64 size);
+    void *(*ReserveLargePages)(u64 size);
+    void *(*ReserveAt)(void *address, u64 size);
+    void *(*ReserveRing)(u64 size);
+    void (*ReleaseRing)(void *memory, u64 size);
     void (*OutputError)(char *error_type, char *error_format, ...);
     void (*SaveToFile)(String8 path, void *data, u64 data_len);
     void (*AppendToFile)(String8 path, void *data, u64 data_len);
+    void (*SaveListToFile)(String8 path, String8List *list);
+    void (*AppendListToFile)(String8 path, String8List *list);
+    u64 (*ReadFromFile)(String8 path, u64 offset, void *data, u64 data_len);
     void (*LoadEntireFile)(M_Arena *arena, String8 path, void **data, u64 *data_len);
     char *(*LoadEntireFileAndNullTerminate)(M_Arena *arena, String8 path);
     void (*DeleteFile)(String8 path);
@@ -1,4 +1,12 @@
 #define WINDOW_TITLE           "Application"
 #define PROGRAM_FILENAME       "app"
 #define DEFAULT_WINDOW_WIDTH   1280
-#define DEFAULT_WINDOW_HEIGHT  720
\ No newline at end of file
+#define DEFAULT_WINDOW_HEIGHT  720
+
+// NOTE(rjf): With PERMANENT_ARENA_SNAPSHOT on, the permanent arena is saved
+// next to the executable on exit and restored before PermanentLoad on the
+// next launch (see os->permanent_arena_restored). Bump the version whenever
+// the layout of what the app keeps in the permanent arena changes, so stale
+// snapshots are ignored.
+#define PERMANENT_ARENA_SNAPSHOT          0
+#define PERMANENT_ARENA_SNAPSHOT_VERSION  1
\ No newline at end of file
@@ -8,394 +8,6094 @@ String8FromCString(char *cstring)
     return string;
 }
 
-internal b32
-StringMatchGeneric(String8 a, String8 b, StringMatchFlags flags)
+//~ NOTE(rjf): String Comparison
+
+// NOTE(rjf): All of the comparisons below come down to finding the first
+// byte where two equal-length ranges differ. Case-insensitive comparisons
+// only fold ASCII letters.
+
+internal u64
+StringMismatchScalar(u8 *a, u8 *b, u64 size, b32 case_insensitive)
 {
-    b32 result = 0;
-    
-    if(a.size == b.size || flags & StringMatchFlag_RightSideSloppy)
+    u64 i = 0;
+    if(!case_insensitive)
     {
-        result = 1;
-        for(u64 i = 0; i < a.size && i < b.size; ++i)
+        for(; i + 8 <= size; i += 8)
         {
-            b32 character_match = 0;
-            
-            if(a.str[i] == b.str[i])
-            {
-                character_match = 1;
-            }
-            else
-            {
-                if(flags & StringMatchFlag_MatchCase)
-                {
-                    if(CharToUpper(a.str[i]) == CharToUpper(b.str[i]))
-                    {
-                        character_match = 1;
-                    }
-                }
-            }
-            
-            if(!character_match)
+            u64 a8, b8;
+            MemoryCopy(&a8, a + i, 8);
+            MemoryCopy(&b8, b + i, 8);
+            if(a8 != b8)
             {
-                result = 0;
-                break;
+                return i + LowestSetBitU64(a8 ^ b8) / 8;
             }
         }
     }
-    
-    return result;
+    for(; i < size; ++i)
+    {
+        u8 a1 = a[i];
+        u8 b1 = b[i];
+        if(case_insensitive)
+        {
+            a1 = CharToLower(a1);
+            b1 = CharToLower(b1);
+        }
+        if(a1 != b1)
+        {
+            break;
+        }
+    }
+    return i;
 }
 
-internal b32
-StringMatch(String8 a, String8 b)
+// NOTE(rjf): Maps 'A'..'Z' to lowercase. Shifting by 128 - 'A' moves the
+// uppercase range to the bottom of the signed range, so a single signed
+// compare picks it out.
+internal __m128i
+StringLowerSSE2(__m128i x)
 {
-    return StringMatchGeneric(a, b, StringMatchFlag_MatchCase);
+    __m128i ranged = _mm_add_epi8(x, _mm_set1_epi8((char)(128 - 'A')));
+    __m128i is_upper = _mm_cmplt_epi8(ranged, _mm_set1_epi8(-128 + 26));
+    return _mm_or_si128(x, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
 }
 
-internal b32
-StringMatchCaseInsensitive(String8 a, String8 b)
+internal __m128i
+StringUpperSSE2(__m128i x)
 {
-    return StringMatchGeneric(a, b, 0);
+    __m128i ranged = _mm_add_epi8(x, _mm_set1_epi8((char)(128 - 'a')));
+    __m128i is_lower = _mm_cmplt_epi8(ranged, _mm_set1_epi8(-128 + 26));
+    return _mm_andnot_si128(_mm_and_si128(is_lower, _mm_set1_epi8(0x20)), x);
 }
 
-internal i64
-GetFirstIntegerFromString(String8 string)
+// NOTE(rjf): size must be at least 16. The last block is loaded so that it
+// ends at size, overlapping bytes that already matched.
+internal u64
+StringMismatchSSE2(u8 *a, u8 *b, u64 size, b32 case_insensitive)
 {
-    i32 result = 0;
-    b32 found_first_digit = 0;
-    u32 integer_write_pos = 0;
-    u8 integer[64] = {0};
-    u32 read_pos = 0;
-    for(;; ++read_pos)
+    for(u64 i = 0; i < size; i += 16)
     {
-        if(string.str[read_pos] == 0)
+        if(i + 16 > size)
         {
-            break;
+            i = size - 16;
         }
-        if(found_first_digit)
+        __m128i a16 = _mm_loadu_si128((__m128i *)(a + i));
+        __m128i b16 = _mm_loadu_si128((__m128i *)(b + i));
+        if(case_insensitive)
         {
-            if(integer_write_pos == sizeof(integer))
-            {
-                integer[sizeof(integer) - 1] = 0;
-                break;
-            }
-            if(CharIsDigit(string.str[read_pos]) || string.str[read_pos] == '-')
-            {
-                integer[integer_write_pos++] = string.str[read_pos];
-            }
-            else
-            {
-                integer[integer_write_pos++] = 0;
-                break;
-            }
+            a16 = StringLowerSSE2(a16);
+            b16 = StringLowerSSE2(b16);
         }
-        else
+        u32 mismatch = ~(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(a16, b16)) & 0xffff;
+        if(mismatch)
         {
-            if(CharIsDigit(string.str[read_pos]) || string.str[read_pos] == '-')
-            {
-                integer[integer_write_pos++] = string.str[read_pos];
-                found_first_digit = 1;
-            }
+            return i + LowestSetBitU32(mismatch);
         }
     }
-    result = CStringToI32(integer);
-    return result;
+    return size;
 }
 
-internal f32
-GetFirstF32FromCString(char *str)
+TARGET_AVX2 internal __m256i
+StringLowerAVX2(__m256i x)
 {
-    f32 result = 0;
-    b32 found_first_digit = 0;
-    u32 float_write_pos = 0;
-    char float_str[64] = {0};
-    u32 read_pos = 0;
-    for(;; ++read_pos)
+    __m256i ranged = _mm256_add_epi8(x, _mm256_set1_epi8((char)(128 - 'A')));
+    __m256i is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), ranged);
+    return _mm256_or_si256(x, _mm256_and_si256(is_upper, _mm256_set1_epi8(0x20)));
+}
+
+TARGET_AVX2 internal __m256i
+StringUpperAVX2(__m256i x)
+{
+    __m256i ranged = _mm256_add_epi8(x, _mm256_set1_epi8((char)(128 - 'a')));
+    __m256i is_lower = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), ranged);
+    return _mm256_andnot_si256(_mm256_and_si256(is_lower, _mm256_set1_epi8(0x20)), x);
+}
+
+// NOTE(rjf): size must be at least 32.
+TARGET_AVX2 internal u64
+StringMismatchAVX2(u8 *a, u8 *b, u64 size, b32 case_insensitive)
+{
+    for(u64 i = 0; i < size; i += 32)
     {
-        if(str[read_pos] == 0)
+        if(i + 32 > size)
         {
-            break;
+            i = size - 32;
         }
-        if(found_first_digit)
+        __m256i a32 = _mm256_loadu_si256((__m256i *)(a + i));
+        __m256i b32 = _mm256_loadu_si256((__m256i *)(b + i));
+        if(case_insensitive)
         {
-            if(float_write_pos == sizeof(float_str))
-            {
-                float_str[sizeof(float_str) - 1] = 0;
-                break;
-            }
-            if(CharIsDigit(str[read_pos]) || str[read_pos] == '.' || str[read_pos] == '-')
-            {
-                float_str[float_write_pos++] = str[read_pos];
-            }
-            else
-            {
-                float_str[float_write_pos++] = 0;
-                break;
-            }
+            a32 = StringLowerAVX2(a32);
+            b32 = StringLowerAVX2(b32);
         }
-        else
+        u32 mismatch = ~(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a32, b32));
+        if(mismatch)
         {
-            if(CharIsDigit(str[read_pos]) || str[read_pos] == '.' || str[read_pos] == '-')
-            {
-                float_str[float_write_pos++] = str[read_pos];
-                found_first_digit = 1;
-            }
+            return i + LowestSetBitU32(mismatch);
         }
     }
-    result = CStringToF32(float_str);
+    return size;
+}
+
+// NOTE(rjf): Returns the index of the first byte where a and b differ, or
+// size if they don't.
+internal u64
+StringMismatch(u8 *a, u8 *b, u64 size, b32 case_insensitive)
+{
+    u64 result = 0;
+    if(size >= 32 && CPUHas(AVX2))
+    {
+        result = StringMismatchAVX2(a, b, size, case_insensitive);
+    }
+    else if(size >= 16)
+    {
+        result = StringMismatchSSE2(a, b, size, case_insensitive);
+    }
+    else
+    {
+        result = StringMismatchScalar(a, b, size, case_insensitive);
+    }
     return result;
 }
 
-internal void
-CopySubstringToStringUntilCharN(char *str1, u32 str1_max,
-                                const char *str2, char str2_term)
+internal b32
+StringMatchGeneric(String8 a, String8 b, StringMatchFlags flags)
 {
-    u32 write_pos = 0;
-    while(1)
+    b32 result = 0;
+    if(a.size == b.size || flags & StringMatchFlag_RightSideSloppy)
     {
-        if(str2[write_pos] == str2_term || write_pos == str1_max - 1)
+        u64 size = Min(a.size, b.size);
+        result = StringMismatch(a.str, b.str, size, !!(flags & StringMatchFlag_CaseInsensitive)) == size;
+    }
+    return result;
+}
+
+internal b32
+StringMatch(String8 a, String8 b)
+{
+    return StringMatchGeneric(a, b, 0);
+}
+
+internal b32
+StringMatchCaseInsensitive(String8 a, String8 b)
+{
+    return StringMatchGeneric(a, b, StringMatchFlag_CaseInsensitive);
+}
+
+internal b32
+StringHasPrefix(String8 string, String8 prefix, StringMatchFlags flags)
+{
+    b32 result = 0;
+    if(string.size >= prefix.size)
+    {
+        result = StringMismatch(string.str, prefix.str, prefix.size, !!(flags & StringMatchFlag_CaseInsensitive)) == prefix.size;
+    }
+    return result;
+}
+
+// NOTE(rjf): Lexicographic byte order, like memcmp; a string sorts before
+// any longer string it is a prefix of. Case-insensitive comparisons order
+// by the lowercased bytes.
+internal i32
+StringCompare(String8 a, String8 b, StringMatchFlags flags)
+{
+    i32 result = 0;
+    b32 case_insensitive = !!(flags & StringMatchFlag_CaseInsensitive);
+    u64 size = Min(a.size, b.size);
+    u64 index = StringMismatch(a.str, b.str, size, case_insensitive);
+    if(index < size)
+    {
+        u8 a1 = a.str[index];
+        u8 b1 = b.str[index];
+        if(case_insensitive)
         {
-            str1[write_pos++] = 0;
-            break;
+            a1 = CharToLower(a1);
+            b1 = CharToLower(b1);
         }
-        else
+        result = a1 < b1 ? -1 : 1;
+    }
+    else if(a.size != b.size)
+    {
+        result = a.size < b.size ? -1 : 1;
+    }
+    return result;
+}
+
+//~ NOTE(rjf): Case Conversion
+
+// NOTE(rjf): Conversions are in place. Past one vector width, the last
+// block overlaps the one before it, which is fine since converting twice
+// changes nothing.
+
+internal void
+ConvertStringCaseSSE2(u8 *str, u64 size, b32 upper)
+{
+    for(u64 i = 0; i < size; i += 16)
+    {
+        if(i + 16 > size)
         {
-            str1[write_pos] = str2[write_pos];
-            ++write_pos;
+            i = size - 16;
         }
+        __m128i x = _mm_loadu_si128((__m128i *)(str + i));
+        x = upper ? StringUpperSSE2(x) : StringLowerSSE2(x);
+        _mm_storeu_si128((__m128i *)(str + i), x);
     }
 }
 
-internal void
-CopyStringToFixedSizeBuffer(char *dest, u32 dest_max,
-                            const char *src)
+TARGET_AVX2 internal void
+ConvertStringCaseAVX2(u8 *str, u64 size, b32 upper)
 {
-    u32 read_pos = 0;
-    u32 write_pos = 0;
-    for(;;)
+    for(u64 i = 0; i < size; i += 32)
     {
-        if(src[read_pos] == 0 || write_pos >= dest_max)
+        if(i + 32 > size)
         {
-            break;
+            i = size - 32;
         }
-        dest[write_pos++] = src[read_pos++];
+        __m256i x = _mm256_loadu_si256((__m256i *)(str + i));
+        x = upper ? StringUpperAVX2(x) : StringLowerAVX2(x);
+        _mm256_storeu_si256((__m256i *)(str + i), x);
     }
-    if(write_pos >= dest_max)
+}
+
+internal void
+ConvertStringCase(u8 *str, u64 size, b32 upper)
+{
+    if(size >= 32 && CPUHas(AVX2))
     {
-        dest[dest_max - 1] = 0;
+        ConvertStringCaseAVX2(str, size, upper);
+    }
+    else if(size >= 16)
+    {
+        ConvertStringCaseSSE2(str, size, upper);
     }
     else
     {
-        dest[write_pos++] = 0;
+        for(u64 i = 0; i < size; ++i)
+        {
+            str[i] = upper ? CharToUpper(str[i]) : CharToLower(str[i]);
+        }
     }
 }
 
-internal u32
-CStringIndexAfterSubstring(char *str, char *substr)
+internal String8
+ConvertStringToLowercase(String8 string)
 {
-    u32 result = 0;
-    for(u32 i = 0; str[i]; ++i)
+    ConvertStringCase(string.str, string.size, 0);
+    return string;
+}
+
+internal String8
+ConvertStringToUppercase(String8 string)
+{
+    ConvertStringCase(string.str, string.size, 1);
+    return string;
+}
+
+//~ NOTE(rjf): Substring Search
+
+// NOTE(rjf): Searches return the index of the match, or haystack.size if
+// there is none. The SIMD paths test every position in a block at once
+// against the needle's first and last byte, and only compare the rest of
+// the needle where both match, so most of the haystack is never touched
+// byte by byte.
+
+internal b32
+StringMatchAt(u8 *haystack, u8 *needle, u64 needle_size, b32 case_insensitive)
+{
+    return StringMismatch(haystack, needle, needle_size, case_insensitive) == needle_size;
+}
+
+internal u64
+StringFindScalar(u8 *haystack, u64 haystack_size, u8 *needle, u64 needle_size, u64 start, b32 case_insensitive)
+{
+    u8 first = case_insensitive ? CharToLower(needle[0]) : needle[0];
+    for(u64 i = start; i + needle_size <= haystack_size; ++i)
     {
-        if(str[i] == substr[0])
+        u8 c = case_insensitive ? CharToLower(haystack[i]) : haystack[i];
+        if(c == first && StringMatchAt(haystack + i + 1, needle + 1, needle_size - 1, case_insensitive))
         {
-            if(CStringMatchCaseInsensitiveN(str + i, substr, CalculateCStringLength(substr)))
-            {
-                result = i + CalculateCStringLength(substr);
-            }
+            return i;
         }
     }
-    return result;
+    return haystack_size;
 }
 
-internal u32
-CStringFirstIndexAfterSubstring(char *str, char *substr)
+internal u64
+StringFindSSE2(u8 *haystack, u64 haystack_size, u8 *needle, u64 needle_size, u64 start, b32 case_insensitive)
 {
-    u32 result = 0;
-    for(u32 i = 0; str[i]; ++i)
+    u8 first_byte = needle[0];
+    u8 last_byte = needle[needle_size-1];
+    if(case_insensitive)
+    {
+        first_byte = CharToLower(first_byte);
+        last_byte = CharToLower(last_byte);
+    }
+    __m128i first = _mm_set1_epi8((char)first_byte);
+    __m128i last = _mm_set1_epi8((char)last_byte);
+    u64 position_count = haystack_size - needle_size + 1;
+    
+    u64 i = start;
+    for(; i + 16 <= position_count; i += 16)
     {
-        if(str[i] == substr[0])
+        __m128i block_first = _mm_loadu_si128((__m128i *)(haystack + i));
+        __m128i block_last = _mm_loadu_si128((__m128i *)(haystack + i + needle_size - 1));
+        if(case_insensitive)
+        {
+            block_first = StringLowerSSE2(block_first);
+            block_last = StringLowerSSE2(block_last);
+        }
+        u32 candidates = (u32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                                                              _mm_cmpeq_epi8(block_last, last)));
+        while(candidates)
         {
-            if(CStringMatchCaseInsensitiveN(str + i, substr, CalculateCStringLength(substr)))
+            u64 position = i + LowestSetBitU32(candidates);
+            if(needle_size <= 2 ||
+               StringMatchAt(haystack + position + 1, needle + 1, needle_size - 2, case_insensitive))
             {
-                result = i + CalculateCStringLength(substr);
-                break;
+                return position;
             }
+            candidates &= candidates - 1;
         }
     }
-    return result;
+    return StringFindScalar(haystack, haystack_size, needle, needle_size, i, case_insensitive);
 }
 
-internal void
-CopyCStringToFixedSizeBuffer(char *destination, u32 destination_max, char *source)
+TARGET_AVX2 internal u64
+StringFindAVX2(u8 *haystack, u64 haystack_size, u8 *needle, u64 needle_size, u64 start, b32 case_insensitive)
 {
-    for(u32 i = 0; i < destination_max; ++i)
+    u8 first_byte = needle[0];
+    u8 last_byte = needle[needle_size-1];
+    if(case_insensitive)
     {
-        destination[i] = source[i];
-        if(source[i] == 0)
+        first_byte = CharToLower(first_byte);
+        last_byte = CharToLower(last_byte);
+    }
+    __m256i first = _mm256_set1_epi8((char)first_byte);
+    __m256i last = _mm256_set1_epi8((char)last_byte);
+    u64 position_count = haystack_size - needle_size + 1;
+    
+    u64 i = start;
+    for(; i + 32 <= position_count; i += 32)
+    {
+        __m256i block_first = _mm256_loadu_si256((__m256i *)(haystack + i));
+        __m256i block_last = _mm256_loadu_si256((__m256i *)(haystack + i + needle_size - 1));
+        if(case_insensitive)
         {
-            break;
+            block_first = StringLowerAVX2(block_first);
+            block_last = StringLowerAVX2(block_last);
+        }
+        u32 candidates = (u32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                                                                    _mm256_cmpeq_epi8(block_last, last)));
+        while(candidates)
+        {
+            u64 position = i + LowestSetBitU32(candidates);
+            if(needle_size <= 2 ||
+               StringMatchAt(haystack + position + 1, needle + 1, needle_size - 2, case_insensitive))
+            {
+                return position;
+            }
+            candidates &= candidates - 1;
         }
     }
-    destination[destination_max-1] = 0;
+    return StringFindSSE2(haystack, haystack_size, needle, needle_size, i, case_insensitive);
 }
 
-internal void
-CopyCStringToFixedSizeBufferN(char *destination, u32 destination_max, char *source, u32 source_max)
+// NOTE(rjf): First match starting at or after start. An empty needle matches
+// at start.
+internal u64
+StringFindSubstring(String8 haystack, String8 needle, u64 start, StringMatchFlags flags)
 {
-    for(u32 i = 0; i < destination_max && i < source_max; ++i)
+    u64 result = haystack.size;
+    b32 case_insensitive = !!(flags & StringMatchFlag_CaseInsensitive);
+    if(needle.size == 0)
     {
-        destination[i] = source[i];
-        if(source[i] == 0)
+        result = Min(start, haystack.size);
+    }
+    else if(needle.size <= haystack.size && start <= haystack.size - needle.size)
+    {
+        if(CPUHas(AVX2))
         {
-            break;
+            result = StringFindAVX2(haystack.str, haystack.size, needle.str, needle.size, start, case_insensitive);
+        }
+        else
+        {
+            result = StringFindSSE2(haystack.str, haystack.size, needle.str, needle.size, start, case_insensitive);
         }
     }
-    destination[destination_max-1] = 0;
+    return result;
 }
 
-internal char *
-ConvertCStringToLowercase(char *str)
+// NOTE(rjf): Last match in the haystack. Walks 16-byte blocks from the end,
+// taking candidates from the highest position down.
+internal u64
+StringFindSubstringReverse(String8 haystack, String8 needle, StringMatchFlags flags)
 {
-    for(int i = 0; str[i]; ++i)
+    u64 result = haystack.size;
+    b32 case_insensitive = !!(flags & StringMatchFlag_CaseInsensitive);
+    if(needle.size > 0 && needle.size <= haystack.size)
     {
-        str[i] = CharToLower(str[i]);
+        u8 *h = haystack.str;
+        u8 first_byte = needle.str[0];
+        u8 last_byte = needle.str[needle.size-1];
+        if(case_insensitive)
+        {
+            first_byte = CharToLower(first_byte);
+            last_byte = CharToLower(last_byte);
+        }
+        __m128i first = _mm_set1_epi8((char)first_byte);
+        __m128i last = _mm_set1_epi8((char)last_byte);
+        
+        u64 end = haystack.size - needle.size + 1;
+        for(; end >= 16; end -= 16)
+        {
+            u64 i = end - 16;
+            __m128i block_first = _mm_loadu_si128((__m128i *)(h + i));
+            __m128i block_last = _mm_loadu_si128((__m128i *)(h + i + needle.size - 1));
+            if(case_insensitive)
+            {
+                block_first = StringLowerSSE2(block_first);
+                block_last = StringLowerSSE2(block_last);
+            }
+            u32 candidates = (u32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                                                                  _mm_cmpeq_epi8(block_last, last)));
+            while(candidates)
+            {
+                u32 bit = HighestSetBitU32(candidates);
+                if(needle.size <= 2 ||
+                   StringMatchAt(h + i + bit + 1, needle.str + 1, needle.size - 2, case_insensitive))
+                {
+                    return i + bit;
+                }
+                candidates &= ~(1u << bit);
+            }
+        }
+        for(u64 i = end; i > 0; --i)
+        {
+            if(StringMatchAt(h + i - 1, needle.str, needle.size, case_insensitive))
+            {
+                return i - 1;
+            }
+        }
     }
-    return str;
+    return result;
 }
 
-internal char *
-ConvertCStringToUppercase(char *str)
+// NOTE(rjf): Every non-overlapping match, as an M_Array of u64 indices.
+internal M_Array
+StringFindAllSubstrings(M_Arena *arena, String8 haystack, String8 needle, StringMatchFlags flags)
 {
-    for(int i = 0; str[i]; ++i)
+    M_Array matches = M_ArrayInitializeForType(arena, u64, 0);
+    if(needle.size > 0)
     {
-        str[i] = CharToUpper(str[i]);
+        for(u64 i = StringFindSubstring(haystack, needle, 0, flags);
+            i < haystack.size;
+            i = StringFindSubstring(haystack, needle, i + needle.size, flags))
+        {
+            *M_ArrayPushType(&matches, u64) = i;
+        }
     }
-    return str;
+    M_ArrayShrinkToFit(&matches);
+    return matches;
 }
 
-internal char *
-ConvertCStringToLowercaseWithUnderscores(char *str)
+// NOTE(rjf): Earliest match of any of the needles. Each needle's scan stops
+// at the best match found so far, so later needles only look at a shrinking
+// prefix. When two needles match at the same place, the earlier needle wins.
+internal u64
+StringFindFirstOfSubstrings(String8 haystack, String8 *needles, u32 needle_count, u64 start,
+                            StringMatchFlags flags, u32 *needle_index_out)
 {
-    for(int i = 0; str[i]; ++i)
+    u64 result = haystack.size;
+    u32 needle_index = needle_count;
+    for(u32 i = 0; i < needle_count; ++i)
     {
-        if(str[i] == ' ')
+        String8 window = haystack;
+        if(result < haystack.size)
         {
-            str[i] = '_';
+            window.size = Min(haystack.size, result + needles[i].size - 1);
         }
-        else
+        u64 position = StringFindSubstring(window, needles[i], start, flags);
+        if(position < window.size && position < result)
         {
-            str[i] = CharToLower(str[i]);
+            result = position;
+            needle_index = i;
         }
     }
-    return str;
+    if(needle_index_out)
+    {
+        *needle_index_out = needle_index;
+    }
+    return result;
 }
 
-internal String8
-PushStringFV(M_Arena *arena, char *format, va_list args)
-{
-    va_list args2;
-    va_copy(args2, args);
-    u32 needed_bytes = vsnprintf(0, 0, format, args) + 1;
-    String8 result = {0};
-    result.str = M_ArenaPush(arena, needed_bytes);
-    result.size = vsnprintf((char*)result.str, needed_bytes, format, args2);
+//~ NOTE(rjf): Number Parsing
+
+// NOTE(rjf): Parsers read straight out of the string, stop at the first byte
+// that can't continue the number, and return how many bytes they used (0 if
+// there was no number there). Integers that don't fit saturate. Floats are
+// correctly rounded: the common cases use Clinger's exact fast path or the
+// Eisel-Lemire algorithm (as in fast_float); the rare inputs those can't
+// decide (more than 19 significant digits landing near a halfway point) are
+// copied to scratch memory and handed to strtod.
+
+internal b32
+ParseIsEightDigits(u64 v)
+{
+    return ((v & 0xf0f0f0f0f0f0f0f0ull) |
+            (((v + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// NOTE(rjf): Eight ASCII digits (first digit in the lowest byte) to their
+// value, combining pairs, then quads, then both halves with multiplies.
+internal u32
+ParseEightDigits(u64 v)
+{
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000ff000000ffull) * 0x000f424000000064ull) +
+         (((v >> 16) & 0x000000ff000000ffull) * 0x0000271000000001ull)) >> 32;
+    return (u32)v;
+}
+
+internal u64
+ParseU64(String8 string, u64 *value_out)
+{
+    u8 *p = string.str;
+    u8 *end = p + string.size;
+    u64 value = 0;
+    
+    // NOTE(rjf): 16 digits always fit, so those can go eight at a time.
+    while(end - p >= 8 && p - string.str <= 8)
+    {
+        u64 eight;
+        MemoryCopy(&eight, p, 8);
+        if(!ParseIsEightDigits(eight))
+        {
+            break;
+        }
+        value = value*100000000 + ParseEightDigits(eight);
+        p += 8;
+    }
+    for(; p < end && CharIsDigit(*p); ++p)
+    {
+        u64 digit = *p - '0';
+        if(value > (0xffffffffffffffffull - digit) / 10)
+        {
+            value = 0xffffffffffffffffull;
+        }
+        else
+        {
+            value = value*10 + digit;
+        }
+    }
+    
+    *value_out = value;
+    return (u64)(p - string.str);
+}
+
+internal u64
+ParseI64(String8 string, i64 *value_out)
+{
+    u64 sign_size = 0;
+    b32 negative = 0;
+    if(string.size && (string.str[0] == '-' || string.str[0] == '+'))
+    {
+        negative = string.str[0] == '-';
+        sign_size = 1;
+    }
+    u64 magnitude = 0;
+    u64 digits_size = ParseU64(S8(string.str + sign_size, string.size - sign_size), &magnitude);
+    i64 value = 0;
+    if(negative)
+    {
+        value = magnitude >= 0x8000000000000000ull ? (i64)0x8000000000000000ull : -(i64)magnitude;
+    }
+    else
+    {
+        value = magnitude >= 0x7fffffffffffffffull ? 0x7fffffffffffffff : (i64)magnitude;
+    }
+    *value_out = value;
+    return digits_size ? sign_size + digits_size : 0;
+}
+
+// NOTE(rjf): 128-bit truncations of 5^q for q in [-342, 308], normalized so
+// the top bit is set, as in fast_float. Entry i holds q = i - 342.
+#define PARSE_POWER_OF_FIVE_MIN -342
+#define PARSE_POWER_OF_FIVE_MAX 308
+
+global u64 global_power_of_five_128[] =
+{
+    0xeef453d6923bd65aull, 0x113faa2906a13b3full,
+    0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull,
+    0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull,
+    0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull,
+    0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull,
+    0xb64ec836a47146f9ull, 0x9748e2826cdee284ull,
+    0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull,
+    0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull,
+    0xb208ef855c969f4full, 0xbdbd2d335e51a935ull,
+    0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull,
+    0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull,
+    0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull,
+    0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull,
+    0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull,
+    0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull,
+    0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull,
+    0x84a57695fe98746dull, 0x014bb630f7604b57ull,
+    0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull,
+    0xcf42894a5dce35eaull, 0x52064cac828675b9ull,
+    0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull,
+    0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull,
+    0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull,
+    0xfd00b897478238d0ull, 0x8920b098955522b4ull,
+    0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull,
+    0xc5a890362fddbc62ull, 0xeb2189f734aa831dull,
+    0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull,
+    0x9a6bb0aa55653b2dull, 0x47b233c92125366eull,
+    0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull,
+    0xf148440a256e2c76ull, 0xc00670ea43ca250dull,
+    0x96cd2a865764dbcaull, 0x380406926a5e5728ull,
+    0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull,
+    0xeba09271e88d976bull, 0xf7864a44c633682eull,
+    0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull,
+    0xb8157268fdae9e4cull, 0x5960ea05bad82964ull,
+    0xe61acf033d1a45dfull, 0x6fb92487298e33bdull,
+    0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull,
+    0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull,
+    0xe0b62e2929aba83cull, 0x331acdabfe94de87ull,
+    0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull,
+    0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull,
+    0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull,
+    0x892731ac9faf056eull, 0xbe311c083a225cd2ull,
+    0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull,
+    0xd64d3d9db981787dull, 0x092cbbccdad5b108ull,
+    0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull,
+    0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull,
+    0xd1476e2c07286faaull, 0x1af5af660db4aee1ull,
+    0x82cca4db847945caull, 0x50d98d9fc890ed4dull,
+    0xa37fce126597973cull, 0xe50ff107bab528a0ull,
+    0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull,
+    0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull,
+    0x9faacf3df73609b1ull, 0x77b191618c54e9acull,
+    0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull,
+    0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull,
+    0x9becce62836ac577ull, 0x4ee367f9430aec32ull,
+    0xc2e801fb244576d5ull, 0x229c41f793cda73full,
+    0xf3a20279ed56d48aull, 0x6b43527578c1110full,
+    0x9845418c345644d6ull, 0x830a13896b78aaa9ull,
+    0xbe5691ef416bd60cull, 0x23cc986bc656d553ull,
+    0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull,
+    0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull,
+    0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull,
+    0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull,
+    0x91376c36d99995beull, 0x23100809b9c21fa1ull,
+    0xb58547448ffffb2dull, 0xabd40a0c2832a78aull,
+    0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull,
+    0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull,
+    0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull,
+    0xdd95317f31c7fa1dull, 0x40405643d711d583ull,
+    0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull,
+    0xad1c8eab5ee43b66ull, 0xda3243650005eecfull,
+    0xd863b256369d4a40ull, 0x90bed43e40076a82ull,
+    0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull,
+    0xa90de3535aaae202ull, 0x711515d0a205cb36ull,
+    0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull,
+    0x8412d9991ed58091ull, 0xe858790afe9486c2ull,
+    0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull,
+    0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full,
+    0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull,
+    0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull,
+    0xc987434744ac874eull, 0xa327ffb266b56220ull,
+    0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull,
+    0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull,
+    0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull,
+    0xf6019da07f549b2bull, 0x7e2a53a146606a48ull,
+    0x99c102844f94e0fbull, 0x2eda7444cbfc426dull,
+    0xc0314325637a1939ull, 0xfa911155fefb5308ull,
+    0xf03d93eebc589f88ull, 0x793555ab7eba27caull,
+    0x96267c7535b763b5ull, 0x4bc1558b2f3458deull,
+    0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull,
+    0xea9c227723ee8bcbull, 0x465e15a979c1cadcull,
+    0x92a1958a7675175full, 0x0bfacd89ec191ec9ull,
+    0xb749faed14125d36ull, 0xcef980ec671f667bull,
+    0xe51c79a85916f484ull, 0x82b7e12780e7401aull,
+    0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull,
+    0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull,
+    0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull,
+    0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull,
+    0xaecc49914078536dull, 0x58fae9f773886e18ull,
+    0xda7f5bf590966848ull, 0xaf39a475506a899eull,
+    0x888f99797a5e012dull, 0x6d8406c952429603ull,
+    0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull,
+    0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull,
+    0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full,
+    0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull,
+    0xd0601d8efc57b08bull, 0xf13b94daf124da26ull,
+    0x823c12795db6ce57ull, 0x76c53d08d6b70858ull,
+    0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull,
+    0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull,
+    0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull,
+    0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull,
+    0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull,
+    0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull,
+    0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull,
+    0xc21094364dfb5636ull, 0x985915fc12f542e4ull,
+    0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull,
+    0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull,
+    0xbd8430bd08277231ull, 0x50c6ff782a838353ull,
+    0xece53cec4a314ebdull, 0xa4f8bf5635246428ull,
+    0x940f4613ae5ed136ull, 0x871b7795e136be99ull,
+    0xb913179899f68584ull, 0x28e2557b59846e3full,
+    0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull,
+    0x9096ea6f3848984full, 0x3ff0d2c85def7621ull,
+    0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull,
+    0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull,
+    0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull,
+    0xb080392cc4349decull, 0xbd8d794d96aacfb3ull,
+    0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull,
+    0x89e42caaf9491b60ull, 0xf41686c49db57244ull,
+    0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull,
+    0xd77485cb25823ac7ull, 0x7d633293366b828bull,
+    0x86a8d39ef77164bcull, 0xae5dff9c02033197ull,
+    0xa8530886b54dbdebull, 0xd9f57f830283fdfcull,
+    0xd267caa862a12d66ull, 0xd072df63c324fd7bull,
+    0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull,
+    0xa46116538d0deb78ull, 0x52d9be85f074e608ull,
+    0xcd795be870516656ull, 0x67902e276c921f8bull,
+    0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull,
+    0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull,
+    0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull,
+    0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull,
+    0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull,
+    0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull,
+    0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull,
+    0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull,
+    0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull,
+    0xef340a98172aace4ull, 0x86fb897116c87c34ull,
+    0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull,
+    0xbae0a846d2195712ull, 0x8974836059cca109ull,
+    0xe998d258869facd7ull, 0x2bd1a438703fc94bull,
+    0x91ff83775423cc06ull, 0x7b6306a34627ddcfull,
+    0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull,
+    0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull,
+    0x8e938662882af53eull, 0x547eb47b7282ee9cull,
+    0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull,
+    0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull,
+    0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull,
+    0xae0b158b4738705eull, 0x9624ab50b148d445ull,
+    0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull,
+    0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull,
+    0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull,
+    0xd47487cc8470652bull, 0x7647c3200069671full,
+    0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull,
+    0xa5fb0a17c777cf09ull, 0xf468107100525890ull,
+    0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull,
+    0x81ac1fe293d599bfull, 0xc6f14cd848405530ull,
+    0xa21727db38cb002full, 0xb8ada00e5a506a7cull,
+    0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull,
+    0xfd442e4688bd304aull, 0x908f4a166d1da663ull,
+    0x9e4a9cec15763e2eull, 0x9a598e4e043287feull,
+    0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull,
+    0xf7549530e188c128ull, 0xd12bee59e68ef47cull,
+    0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull,
+    0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull,
+    0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull,
+    0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull,
+    0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull,
+    0xebdf661791d60f56ull, 0x111b495b3464ad21ull,
+    0x936b9fcebb25c995ull, 0xcab10dd900beec34ull,
+    0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull,
+    0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull,
+    0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull,
+    0xb3f4e093db73a093ull, 0x59ed216765690f56ull,
+    0xe0f218b8d25088b8ull, 0x306869c13ec3532cull,
+    0x8c974f7383725573ull, 0x1e414218c73a13fbull,
+    0xafbd2350644eeacfull, 0xe5d1929ef90898faull,
+    0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull,
+    0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull,
+    0xab9eb47c81f5114full, 0x066ea92f3f326564ull,
+    0xd686619ba27255a2ull, 0xc80a537b0efefebdull,
+    0x8613fd0145877585ull, 0xbd06742ce95f5f36ull,
+    0xa798fc4196e952e7ull, 0x2c48113823b73704ull,
+    0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull,
+    0x82ef85133de648c4ull, 0x9a984d73dbe722fbull,
+    0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull,
+    0xcc963fee10b7d1b3ull, 0x318df905079926a8ull,
+    0xffbbcfe994e5c61full, 0xfdf17746497f7052ull,
+    0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull,
+    0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull,
+    0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull,
+    0x9c1661a651213e2dull, 0x06bea10ca65c084eull,
+    0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull,
+    0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull,
+    0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull,
+    0xbe89523386091465ull, 0xf6bbb397f1135823ull,
+    0xee2ba6c0678b597full, 0x746aa07ded582e2cull,
+    0x94db483840b717efull, 0xa8c2a44eb4571cdcull,
+    0xba121a4650e4ddebull, 0x92f34d62616ce413ull,
+    0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull,
+    0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull,
+    0xb5b5ada8aaff80b8ull, 0x0d819992132456baull,
+    0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull,
+    0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull,
+    0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull,
+    0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull,
+    0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull,
+    0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull,
+    0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull,
+    0x87625f056c7c4a8bull, 0x11471cd764ad4972ull,
+    0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull,
+    0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull,
+    0x843610cb4bf160cbull, 0xcedf722a585139baull,
+    0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull,
+    0xce947a3da6a9273eull, 0x733d226229feea32ull,
+    0x811ccc668829b887ull, 0x0806357d5a3f525full,
+    0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull,
+    0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull,
+    0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull,
+    0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull,
+    0xc5029163f384a931ull, 0x0a9e795e65d4df11ull,
+    0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull,
+    0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull,
+    0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull,
+    0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull,
+    0x964e858c91ba2655ull, 0x3a6a07f8d510f86full,
+    0xbbe226efb628afeaull, 0x890489f70a55368bull,
+    0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull,
+    0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull,
+    0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull,
+    0xe55990879ddcaabdull, 0xcc420a6a101d0515ull,
+    0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull,
+    0xb32df8e9f3546564ull, 0x47939822dc96abf9ull,
+    0xdff9772470297ebdull, 0x59787e2b93bc56f7ull,
+    0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull,
+    0xaefae51477a06b03ull, 0xede622920b6b23f1ull,
+    0xdab99e59958885c4ull, 0xe95fab368e45ecedull,
+    0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull,
+    0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull,
+    0xd59944a37c0752a2ull, 0x4be76d3346f0495full,
+    0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull,
+    0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull,
+    0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull,
+    0x825ecc24c873782full, 0x8ed400668c0c28c8ull,
+    0xa2f67f2dfa90563bull, 0x728900802f0f32faull,
+    0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull,
+    0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull,
+    0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull,
+    0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull,
+    0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull,
+    0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull,
+    0xc24452da229b021bull, 0xfbe85badce996168ull,
+    0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull,
+    0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull,
+    0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull,
+    0xed246723473e3813ull, 0x290123e9aab23b68ull,
+    0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull,
+    0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull,
+    0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull,
+    0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull,
+    0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull,
+    0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull,
+    0x8d590723948a535full, 0x579c487e5a38ad0eull,
+    0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull,
+    0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull,
+    0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull,
+    0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full,
+    0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full,
+    0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull,
+    0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull,
+    0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull,
+    0x83a3eeeef9153e89ull, 0x1953cf68300424acull,
+    0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull,
+    0xcdb02555653131b6ull, 0x3792f412cb06794dull,
+    0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull,
+    0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull,
+    0xc8de047564d20a8bull, 0xf245825a5a445275ull,
+    0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull,
+    0x9ced737bb6c4183dull, 0x55464dd69685606bull,
+    0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull,
+    0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull,
+    0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull,
+    0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull,
+    0xef73d256a5c0f77cull, 0x963e66858f6d4440ull,
+    0x95a8637627989aadull, 0xdde7001379a44aa8ull,
+    0xbb127c53b17ec159ull, 0x5560c018580d5d52ull,
+    0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull,
+    0x9226712162ab070dull, 0xcab3961304ca70e8ull,
+    0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull,
+    0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull,
+    0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull,
+    0xb267ed1940f1c61cull, 0x55f038b237591ed3ull,
+    0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull,
+    0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull,
+    0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull,
+    0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull,
+    0x881cea14545c7575ull, 0x7e50d64177da2e54ull,
+    0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull,
+    0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull,
+    0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull,
+    0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull,
+    0xcfb11ead453994baull, 0x67de18eda5814af2ull,
+    0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull,
+    0xa2425ff75e14fc31ull, 0xa1258379a94d028dull,
+    0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull,
+    0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull,
+    0x9e74d1b791e07e48ull, 0x775ea264cf55347eull,
+    0xc612062576589ddaull, 0x95364afe032a819eull,
+    0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull,
+    0x9abe14cd44753b52ull, 0xc4926a9672793543ull,
+    0xc16d9a0095928a27ull, 0x75b7053c0f178294ull,
+    0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull,
+    0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull,
+    0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull,
+    0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull,
+    0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull,
+    0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull,
+    0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull,
+    0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull,
+    0xb424dc35095cd80full, 0x538484c19ef38c95ull,
+    0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull,
+    0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull,
+    0xafebff0bcb24aafeull, 0xf78f69a51539d749ull,
+    0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull,
+    0x89705f4136b4a597ull, 0x31680a88f8953031ull,
+    0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull,
+    0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull,
+    0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull,
+    0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull,
+    0xd1b71758e219652bull, 0xd3c36113404ea4a9ull,
+    0x83126e978d4fdf3bull, 0x645a1cac083126eaull,
+    0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull,
+    0xccccccccccccccccull, 0xcccccccccccccccdull,
+    0x8000000000000000ull, 0x0000000000000000ull,
+    0xa000000000000000ull, 0x0000000000000000ull,
+    0xc800000000000000ull, 0x0000000000000000ull,
+    0xfa00000000000000ull, 0x0000000000000000ull,
+    0x9c40000000000000ull, 0x0000000000000000ull,
+    0xc350000000000000ull, 0x0000000000000000ull,
+    0xf424000000000000ull, 0x0000000000000000ull,
+    0x9896800000000000ull, 0x0000000000000000ull,
+    0xbebc200000000000ull, 0x0000000000000000ull,
+    0xee6b280000000000ull, 0x0000000000000000ull,
+    0x9502f90000000000ull, 0x0000000000000000ull,
+    0xba43b74000000000ull, 0x0000000000000000ull,
+    0xe8d4a51000000000ull, 0x0000000000000000ull,
+    0x9184e72a00000000ull, 0x0000000000000000ull,
+    0xb5e620f480000000ull, 0x0000000000000000ull,
+    0xe35fa931a0000000ull, 0x0000000000000000ull,
+    0x8e1bc9bf04000000ull, 0x0000000000000000ull,
+    0xb1a2bc2ec5000000ull, 0x0000000000000000ull,
+    0xde0b6b3a76400000ull, 0x0000000000000000ull,
+    0x8ac7230489e80000ull, 0x0000000000000000ull,
+    0xad78ebc5ac620000ull, 0x0000000000000000ull,
+    0xd8d726b7177a8000ull, 0x0000000000000000ull,
+    0x878678326eac9000ull, 0x0000000000000000ull,
+    0xa968163f0a57b400ull, 0x0000000000000000ull,
+    0xd3c21bcecceda100ull, 0x0000000000000000ull,
+    0x84595161401484a0ull, 0x0000000000000000ull,
+    0xa56fa5b99019a5c8ull, 0x0000000000000000ull,
+    0xcecb8f27f4200f3aull, 0x0000000000000000ull,
+    0x813f3978f8940984ull, 0x4000000000000000ull,
+    0xa18f07d736b90be5ull, 0x5000000000000000ull,
+    0xc9f2c9cd04674edeull, 0xa400000000000000ull,
+    0xfc6f7c4045812296ull, 0x4d00000000000000ull,
+    0x9dc5ada82b70b59dull, 0xf020000000000000ull,
+    0xc5371912364ce305ull, 0x6c28000000000000ull,
+    0xf684df56c3e01bc6ull, 0xc732000000000000ull,
+    0x9a130b963a6c115cull, 0x3c7f400000000000ull,
+    0xc097ce7bc90715b3ull, 0x4b9f100000000000ull,
+    0xf0bdc21abb48db20ull, 0x1e86d40000000000ull,
+    0x96769950b50d88f4ull, 0x1314448000000000ull,
+    0xbc143fa4e250eb31ull, 0x17d955a000000000ull,
+    0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull,
+    0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull,
+    0xb7abc627050305adull, 0xf14a3d9e40000000ull,
+    0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull,
+    0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull,
+    0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull,
+    0xe0352f62a19e306eull, 0xd50b2037ad200000ull,
+    0x8c213d9da502de45ull, 0x4526f422cc340000ull,
+    0xaf298d050e4395d6ull, 0x9670b12b7f410000ull,
+    0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull,
+    0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull,
+    0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull,
+    0xd5d238a4abe98068ull, 0x72a4904598d6d880ull,
+    0x85a36366eb71f041ull, 0x47a6da2b7f864750ull,
+    0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull,
+    0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull,
+    0x82818f1281ed449full, 0xbff8f10e7a8921a4ull,
+    0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull,
+    0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull,
+    0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull,
+    0x9f4f2726179a2245ull, 0x01d762422c946590ull,
+    0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull,
+    0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull,
+    0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full,
+    0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull,
+    0xf316271c7fc3908aull, 0x8bef464e3945ef7aull,
+    0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull,
+    0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull,
+    0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull,
+    0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull,
+    0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull,
+    0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull,
+    0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull,
+    0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull,
+    0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull,
+    0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull,
+    0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull,
+    0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull,
+    0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull,
+    0xacb92ed9397bf996ull, 0x49c2c37f07965404ull,
+    0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull,
+    0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull,
+    0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull,
+    0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull,
+    0x83c7088e1aab65dbull, 0x792667c6da79e0faull,
+    0xa4b8cab1a1563f52ull, 0x577001b891185938ull,
+    0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull,
+    0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull,
+    0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull,
+    0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull,
+    0xfb5878494ace3a5full, 0x04ab48a04065c723ull,
+    0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull,
+    0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull,
+    0xf5746577930d6500ull, 0xca8f44ec7ee36479ull,
+    0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull,
+    0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull,
+    0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull,
+    0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull,
+    0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull,
+    0xea1575143cf97226ull, 0xf52d09d71a3293bdull,
+    0x924d692ca61be758ull, 0x593c2626705f9c56ull,
+    0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull,
+    0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull,
+    0x8edf98b59a373fecull, 0x4724bd4189bd5eacull,
+    0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull,
+    0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull,
+    0x8b865b215899f46cull, 0xbd79e0d20082ee74ull,
+    0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull,
+    0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull,
+    0x884134fe908658b2ull, 0x3109058d147fdcddull,
+    0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull,
+    0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull,
+    0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull,
+    0xa6539930bf6bff45ull, 0x84db8346b786151cull,
+    0xcfe87f7cef46ff16ull, 0xe612641865679a63ull,
+    0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull,
+    0xa26da3999aef7749ull, 0xe3be5e330f38f09dull,
+    0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull,
+    0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull,
+    0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull,
+    0xc646d63501a1511dull, 0xb281e1fd541501b8ull,
+    0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull,
+    0x9ae757596946075full, 0x3375788de9b06958ull,
+    0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull,
+    0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull,
+    0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull,
+    0xbd176620a501fbffull, 0xb650e5a93bc3d898ull,
+    0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull,
+    0x93ba47c980e98cdfull, 0xc66f336c36b10137ull,
+    0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull,
+    0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull,
+    0x9043ea1ac7e41392ull, 0x87c89837ad68db2full,
+    0xb454e4a179dd1877ull, 0x29babe4598c311fbull,
+    0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull,
+    0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull,
+    0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full,
+    0xdc21a1171d42645dull, 0x76707543f4fa1f73ull,
+    0x899504ae72497ebaull, 0x6a06494a791c53a8ull,
+    0xabfa45da0edbde69ull, 0x0487db9d17636892ull,
+    0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull,
+    0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull,
+    0xa7f26836f282b732ull, 0x8e6cac7768d7141eull,
+    0xd1ef0244af2364ffull, 0x3207d795430cd926ull,
+    0x8335616aed761f1full, 0x7f44e6bd49e807b8ull,
+    0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull,
+    0xcd036837130890a1ull, 0x36dba887c37a8c0full,
+    0x802221226be55a64ull, 0xc2494954da2c9789ull,
+    0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull,
+    0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull,
+    0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull,
+    0x9c69a97284b578d7ull, 0xff2a760414536efbull,
+    0xc38413cf25e2d70dull, 0xfef5138519684abaull,
+    0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull,
+    0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull,
+    0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull,
+    0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull,
+    0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull,
+    0xba756174393d88dfull, 0x94f971119aeef9e4ull,
+    0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull,
+    0x91abb422ccb812eeull, 0xac62e055c10ab33aull,
+    0xb616a12b7fe617aaull, 0x577b986b314d6009ull,
+    0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull,
+    0x8e41ade9fbebc27dull, 0x14588f13be847307ull,
+    0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull,
+    0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull,
+    0x8aec23d680043beeull, 0x25de7bb9480d5854ull,
+    0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull,
+    0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull,
+    0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull,
+    0xa99541bf57452b28ull, 0x353a1607ac744a53ull,
+    0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull,
+    0x847c9b5d7c2e09b7ull, 0x69956135febada11ull,
+    0xa59bc234db398c25ull, 0x43fab9837e699095ull,
+    0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull,
+    0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull,
+    0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull,
+    0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull,
+    0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull,
+    0x9defbf01b061adabull, 0x3a0888136afa64a7ull,
+    0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull,
+    0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull,
+    0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull,
+    0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull,
+    0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull,
+    0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull,
+    0xbc4665b596706114ull, 0x873d5d9f0dde1feeull,
+    0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull,
+    0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull,
+    0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full,
+    0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull,
+    0x8fa475791a569d10ull, 0xf96e017d694487bcull,
+    0xb38d92d760ec4455ull, 0x37c981dcc395a9acull,
+    0xe070f78d3927556aull, 0x85bbe253f47b1417ull,
+    0x8c469ab843b89562ull, 0x93956d7478ccec8eull,
+    0xaf58416654a6babbull, 0x387ac8d1970027b2ull,
+    0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull,
+    0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull,
+    0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull,
+    0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull,
+    0x85c7056562757456ull, 0xf6872d5667844e49ull,
+    0xa738c6bebb12d16cull, 0xb428f8ac016561dbull,
+    0xd106f86e69d785c7ull, 0xe13336d701beba52ull,
+    0x82a45b450226b39cull, 0xecc0024661173473ull,
+    0xa34d721642b06084ull, 0x27f002d7f95d0190ull,
+    0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull,
+    0xff290242c83396ceull, 0x7e67047175a15271ull,
+    0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull,
+    0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull,
+    0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull,
+    0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull,
+    0xc2abf989935ddbfeull, 0x6acff893d00ea435ull,
+    0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull,
+    0x98165af37b2153deull, 0xc3727a337a8b704aull,
+    0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull,
+    0xeda2ee1c7064130cull, 0x1162def06f79df73ull,
+    0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull,
+    0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull,
+    0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull,
+    0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull,
+    0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull,
+    0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull,
+    0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull,
+    0xb10d8e1456105dadull, 0x7425a83e872c5f47ull,
+    0xdd50f1996b947518ull, 0xd12f124e28f77719ull,
+    0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full,
+    0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull,
+    0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull,
+    0x8714a775e3e95c78ull, 0x65acfaec34810a71ull,
+    0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull,
+    0xd31045a8341ca07cull, 0x1ede48111209a050ull,
+    0x83ea2b892091e44dull, 0x934aed0aab460432ull,
+    0xa4e4b66b68b65d60ull, 0xf81da84d5617853full,
+    0xce1de40642e3f4b9ull, 0x36251260ab9d668eull,
+    0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull,
+    0xa1075a24e4421730ull, 0xb24cf65b8612f81full,
+    0xc94930ae1d529cfcull, 0xdee033f26797b627ull,
+    0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull,
+    0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull,
+    0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull,
+    0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull,
+    0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull,
+    0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull,
+    0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull,
+    0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull,
+    0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull,
+    0xea53df5fd18d5513ull, 0x84c86189216dc5edull,
+    0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull,
+    0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull,
+    0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull,
+    0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull,
+    0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull,
+    0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull,
+    0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull,
+    0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull,
+    0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull,
+    0x8865899617fb1871ull, 0x7e2fa67c7a658892ull,
+    0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull,
+    0xd51ea6fa85785631ull, 0x552a74227f3ea565ull,
+    0x8533285c936b35deull, 0xd53a88958f87275full,
+    0xa67ff273b8460356ull, 0x8a892abaf368f137ull,
+    0xd01fef10a657842cull, 0x2d2b7569b0432d85ull,
+    0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull,
+    0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full,
+    0xcb3f2f7642717713ull, 0x241c70a936219a73ull,
+    0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull,
+    0x9ec95d1463e8a506ull, 0xf4363804324a40aaull,
+    0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull,
+    0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull,
+    0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull,
+    0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull,
+    0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull,
+    0x976e41088617ca01ull, 0xd5be0503e085d813ull,
+    0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull,
+    0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull,
+    0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull,
+    0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull,
+    0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull,
+    0x906a617d450187e2ull, 0x27fb2b80668b24c5ull,
+    0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull,
+    0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull,
+    0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull,
+    0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull,
+    0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull,
+    0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull,
+    0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull,
+    0xd732290fbacaf133ull, 0xa97c177947ad4095ull,
+    0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull,
+    0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull,
+    0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull,
+    0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull,
+    0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull,
+    0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull,
+    0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull,
+    0xa0555e361951c366ull, 0xd7e105bcc332621full,
+    0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull,
+    0xfa856334878fc150ull, 0xb14f98f6f0feb951ull,
+    0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull,
+    0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull,
+    0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull,
+    0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull,
+    0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull,
+    0xeeea5d5004981478ull, 0x1858ccfce06cac74ull,
+    0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull,
+    0xbaa718e68396cffdull, 0xd30560258f54e6baull,
+    0xe950df20247c83fdull, 0x47c6b82ef32a2069ull,
+    0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull,
+    0xb6472e511c81471dull, 0xe0133fe4adf8e952ull,
+    0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull,
+    0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull,
+};
+
+typedef struct ParseFloatFormat ParseFloatFormat;
+struct ParseFloatFormat
+{
+    i32 mantissa_bits;
+    i32 sign_bit;
+    i32 minimum_exponent;
+    i32 infinite_power;
+    i32 smallest_power_of_ten;
+    i32 largest_power_of_ten;
+    i32 min_exponent_round_to_even;
+    i32 max_exponent_round_to_even;
+};
+
+global ParseFloatFormat global_parse_f64_format = { 52, 63, -1023, 0x7ff, -342, 308, -4, 23 };
+global ParseFloatFormat global_parse_f32_format = { 23, 31, -127, 0xff, -65, 38, -17, 10 };
+
+typedef struct ParseDecimal ParseDecimal;
+struct ParseDecimal
+{
+    u64 size;
+    b32 negative;
+    b32 truncated;
+    u64 mantissa;
+    i64 exponent;
+};
+
+// NOTE(rjf): Splits [+-]digits[.digits][(e|E)[+-]digits] into a 64-bit
+// mantissa and a power of ten. Past 19 significant digits the mantissa is
+// truncated to the first 19, and truncated is set.
+internal ParseDecimal
+ParseDecimalFromString(String8 string)
+{
+    ParseDecimal result = {0};
+    u8 *p = string.str;
+    u8 *end = p + string.size;
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        result.negative = *p == '-';
+        ++p;
+    }
+    
+    u8 *integer_start = p;
+    u64 mantissa = 0;
+    while(end - p >= 8)
+    {
+        u64 eight;
+        MemoryCopy(&eight, p, 8);
+        if(!ParseIsEightDigits(eight))
+        {
+            break;
+        }
+        mantissa = mantissa*100000000 + ParseEightDigits(eight);
+        p += 8;
+    }
+    for(; p < end && CharIsDigit(*p); ++p)
+    {
+        mantissa = mantissa*10 + (*p - '0');
+    }
+    u8 *integer_end = p;
+    i64 digit_count = integer_end - integer_start;
+    
+    i64 exponent = 0;
+    u8 *fraction_start = p;
+    u8 *fraction_end = p;
+    if(p < end && *p == '.')
+    {
+        fraction_start = ++p;
+        while(end - p >= 8)
+        {
+            u64 eight;
+            MemoryCopy(&eight, p, 8);
+            if(!ParseIsEightDigits(eight))
+            {
+                break;
+            }
+            mantissa = mantissa*100000000 + ParseEightDigits(eight);
+            p += 8;
+        }
+        for(; p < end && CharIsDigit(*p); ++p)
+        {
+            mantissa = mantissa*10 + (*p - '0');
+        }
+        fraction_end = p;
+        exponent = -(fraction_end - fraction_start);
+        digit_count += fraction_end - fraction_start;
+    }
+    if(digit_count == 0)
+    {
+        return result;
+    }
+    
+    i64 explicit_exponent = 0;
+    if(p < end && (*p == 'e' || *p == 'E'))
+    {
+        u8 *exponent_start = p++;
+        b32 negative_exponent = 0;
+        if(p < end && (*p == '-' || *p == '+'))
+        {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        if(p < end && CharIsDigit(*p))
+        {
+            for(; p < end && CharIsDigit(*p); ++p)
+            {
+                if(explicit_exponent < 0x10000000)
+                {
+                    explicit_exponent = explicit_exponent*10 + (*p - '0');
+                }
+            }
+            if(negative_exponent)
+            {
+                explicit_exponent = -explicit_exponent;
+            }
+            exponent += explicit_exponent;
+        }
+        else
+        {
+            p = exponent_start;
+        }
+    }
+    
+    // NOTE(rjf): Leading zeros don't count towards the 19 digits.
+    if(digit_count > 19)
+    {
+        for(u8 *z = integer_start; z < fraction_end && (*z == '0' || *z == '.'); ++z)
+        {
+            digit_count -= *z == '0';
+        }
+        if(digit_count > 19)
+        {
+            result.truncated = 1;
+            u64 min_19_digits = 1000000000000000000ull;
+            mantissa = 0;
+            u8 *d = integer_start;
+            for(; mantissa < min_19_digits && d < integer_end; ++d)
+            {
+                mantissa = mantissa*10 + (*d - '0');
+            }
+            if(mantissa >= min_19_digits)
+            {
+                exponent = (integer_end - d) + explicit_exponent;
+            }
+            else
+            {
+                d = fraction_start;
+                for(; mantissa < min_19_digits && d < fraction_end; ++d)
+                {
+                    mantissa = mantissa*10 + (*d - '0');
+                }
+                exponent = (fraction_start - d) + explicit_exponent;
+            }
+        }
+    }
+    
+    result.size = (u64)(p - string.str);
+    result.mantissa = mantissa;
+    result.exponent = exponent;
+    return result;
+}
+
+internal u64
+ParseMultiply128(u64 a, u64 b, u64 *high)
+{
+#if _MSC_VER
+    return _umul128(a, b, high);
+#else
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *high = (u64)(product >> 64);
+    return (u64)product;
+#endif
+}
+
+// NOTE(rjf): Eisel-Lemire. Multiplies the normalized mantissa by the
+// truncated 128-bit power of five, keeps enough bits to round, and works out
+// the binary exponent from q. Returns the biased exponent and the mantissa
+// without its implicit bit.
+internal void
+ParseComputeFloat(ParseFloatFormat *format, i64 q, u64 w, i32 *power2_out, u64 *mantissa_out)
+{
+    i32 power2 = 0;
+    u64 mantissa = 0;
+    if(w == 0 || q < format->smallest_power_of_ten)
+    {
+        goto end;
+    }
+    if(q > format->largest_power_of_ten)
+    {
+        power2 = format->infinite_power;
+        goto end;
+    }
+    
+    i32 leading_zeros = 63 - (i32)HighestSetBitU64(w);
+    w <<= leading_zeros;
+    
+    u64 *power = global_power_of_five_128 + 2*(q - PARSE_POWER_OF_FIVE_MIN);
+    u64 high = 0;
+    u64 low = ParseMultiply128(w, power[0], &high);
+    u64 precision_mask = 0xffffffffffffffffull >> (format->mantissa_bits + 3);
+    if((high & precision_mask) == precision_mask)
+    {
+        u64 second_high = 0;
+        ParseMultiply128(w, power[1], &second_high);
+        low += second_high;
+        if(second_high > low)
+        {
+            high += 1;
+        }
+    }
+    
+    i32 upper_bit = (i32)(high >> 63);
+    i32 shift = upper_bit + 64 - format->mantissa_bits - 3;
+    mantissa = high >> shift;
+    power2 = (i32)((((152170 + 65536) * q) >> 16) + 63) + upper_bit - leading_zeros - format->minimum_exponent;
+    
+    if(power2 <= 0)
+    {
+        // NOTE(rjf): Subnormal, or zero if it's too small even for that.
+        if(-power2 + 1 >= 64)
+        {
+            power2 = 0;
+            mantissa = 0;
+            goto end;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < ((u64)1 << format->mantissa_bits) ? 0 : 1;
+        goto end;
+    }
+    
+    // NOTE(rjf): Exactly halfway between two floats only happens when 5^q
+    // fits in 64 bits; in that case round to even instead of up.
+    if(low <= 1 && q >= format->min_exponent_round_to_even && q <= format->max_exponent_round_to_even &&
+       (mantissa & 3) == 1 && (mantissa << shift) == high)
+    {
+        mantissa &= ~(u64)1;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if(mantissa >= ((u64)2 << format->mantissa_bits))
+    {
+        mantissa = (u64)1 << format->mantissa_bits;
+        power2 += 1;
+    }
+    mantissa &= ~((u64)1 << format->mantissa_bits);
+    if(power2 >= format->infinite_power)
+    {
+        power2 = format->infinite_power;
+        mantissa = 0;
+    }
+    
+    end:;
+    *power2_out = power2;
+    *mantissa_out = mantissa;
+}
+
+// NOTE(rjf): Returns the float's bits, or 0xffffffffffffffff if the decimal
+// was truncated and the answer depends on the dropped digits.
+internal u64
+ParseFloatBits(ParseFloatFormat *format, ParseDecimal *decimal)
+{
+    i32 power2 = 0;
+    u64 mantissa = 0;
+    ParseComputeFloat(format, decimal->exponent, decimal->mantissa, &power2, &mantissa);
+    if(decimal->truncated && power2 >= 0)
+    {
+        i32 power2_up = 0;
+        u64 mantissa_up = 0;
+        ParseComputeFloat(format, decimal->exponent, decimal->mantissa + 1, &power2_up, &mantissa_up);
+        if(power2 != power2_up || mantissa != mantissa_up)
+        {
+            return 0xffffffffffffffffull;
+        }
+    }
+    u64 bits = mantissa | ((u64)power2 << format->mantissa_bits);
+    if(decimal->negative)
+    {
+        bits |= (u64)1 << format->sign_bit;
+    }
+    return bits;
+}
+
+internal f64
+ParseFloatFallback(String8 string, b32 single_precision)
+{
+    M_Temp scratch = M_GetScratch(0, 0);
+    char *c_string = M_ArenaPush(scratch.arena, string.size + 1);
+    MemoryCopy(c_string, string.str, string.size);
+    c_string[string.size] = 0;
+    f64 result = single_precision ? strtof(c_string, 0) : strtod(c_string, 0);
+    M_ReleaseScratch(scratch);
+    return result;
+}
+
+global f64 global_parse_exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+internal u64
+ParseF64(String8 string, f64 *value_out)
+{
+    f64 value = 0;
+    ParseDecimal decimal = ParseDecimalFromString(string);
+    if(decimal.size)
+    {
+        // NOTE(rjf): Clinger: both the mantissa and the power of ten are
+        // exact doubles, so one correctly rounded multiply or divide is the
+        // correctly rounded answer.
+        if(!decimal.truncated && decimal.mantissa <= ((u64)1 << 53) &&
+           decimal.exponent >= -22 && decimal.exponent <= 22)
+        {
+            value = (f64)decimal.mantissa;
+            if(decimal.exponent < 0)
+            {
+                value /= global_parse_exact_powers_of_ten[-decimal.exponent];
+            }
+            else
+            {
+                value *= global_parse_exact_powers_of_ten[decimal.exponent];
+            }
+            if(decimal.negative)
+            {
+                value = -value;
+            }
+        }
+        else
+        {
+            u64 bits = ParseFloatBits(&global_parse_f64_format, &decimal);
+            if(bits == 0xffffffffffffffffull)
+            {
+                value = ParseFloatFallback(S8(string.str, decimal.size), 0);
+            }
+            else
+            {
+                MemoryCopy(&value, &bits, sizeof(value));
+            }
+        }
+    }
+    *value_out = value;
+    return decimal.size;
+}
+
+internal u64
+ParseF32(String8 string, f32 *value_out)
+{
+    f32 value = 0;
+    ParseDecimal decimal = ParseDecimalFromString(string);
+    if(decimal.size)
+    {
+        if(!decimal.truncated && decimal.mantissa <= ((u64)1 << 24) &&
+           decimal.exponent >= -10 && decimal.exponent <= 10)
+        {
+            value = (f32)decimal.mantissa;
+            if(decimal.exponent < 0)
+            {
+                value /= (f32)global_parse_exact_powers_of_ten[-decimal.exponent];
+            }
+            else
+            {
+                value *= (f32)global_parse_exact_powers_of_ten[decimal.exponent];
+            }
+            if(decimal.negative)
+            {
+                value = -value;
+            }
+        }
+        else
+        {
+            u64 bits = ParseFloatBits(&global_parse_f32_format, &decimal);
+            if(bits == 0xffffffffffffffffull)
+            {
+                value = (f32)ParseFloatFallback(S8(string.str, decimal.size), 1);
+            }
+            else
+            {
+                u32 bits32 = (u32)bits;
+                MemoryCopy(&value, &bits32, sizeof(value));
+            }
+        }
+    }
+    *value_out = value;
+    return decimal.size;
+}
+
+// NOTE(rjf): Whether a number can start at p: a digit, or a sign and/or
+// decimal point followed by one.
+internal b32
+ParseIsNumberStart(u8 *p, u8 *end, b32 allow_point)
+{
+    if(p < end && (*p == '-' || *p == '+'))
+    {
+        ++p;
+    }
+    if(allow_point && p < end && *p == '.')
+    {
+        ++p;
+    }
+    return p < end && CharIsDigit(*p);
+}
+
+// NOTE(rjf): Bulk versions: every number in the string, in order, as an
+// M_Array. Anything that can't start a number is skipped.
+internal M_Array
+ParseAllI64(M_Arena *arena, String8 string)
+{
+    M_Array values = M_ArrayInitializeForType(arena, i64, 0);
+    u8 *end = string.str + string.size;
+    for(u8 *p = string.str; p < end;)
+    {
+        if(ParseIsNumberStart(p, end, 0))
+        {
+            p += ParseI64(S8(p, end - p), M_ArrayPushType(&values, i64));
+        }
+        else
+        {
+            ++p;
+        }
+    }
+    M_ArrayShrinkToFit(&values);
+    return values;
+}
+
+internal M_Array
+ParseAllF64(M_Arena *arena, String8 string)
+{
+    M_Array values = M_ArrayInitializeForType(arena, f64, 0);
+    u8 *end = string.str + string.size;
+    for(u8 *p = string.str; p < end;)
+    {
+        if(ParseIsNumberStart(p, end, 1))
+        {
+            p += ParseF64(S8(p, end - p), M_ArrayPushType(&values, f64));
+        }
+        else
+        {
+            ++p;
+        }
+    }
+    M_ArrayShrinkToFit(&values);
+    return values;
+}
+
+internal M_Array
+ParseAllF32(M_Arena *arena, String8 string)
+{
+    M_Array values = M_ArrayInitializeForType(arena, f32, 0);
+    u8 *end = string.str + string.size;
+    for(u8 *p = string.str; p < end;)
+    {
+        if(ParseIsNumberStart(p, end, 1))
+        {
+            p += ParseF32(S8(p, end - p), M_ArrayPushType(&values, f32));
+        }
+        else
+        {
+            ++p;
+        }
+    }
+    M_ArrayShrinkToFit(&values);
+    return values;
+}
+
+internal i64
+GetFirstIntegerFromString(String8 string)
+{
+    i64 result = 0;
+    u8 *end = string.str + string.size;
+    for(u8 *p = string.str; p < end; ++p)
+    {
+        if(ParseIsNumberStart(p, end, 0))
+        {
+            ParseI64(S8(p, end - p), &result);
+            break;
+        }
+    }
+    return result;
+}
+
+internal f32
+GetFirstF32FromCString(char *str)
+{
+    f32 result = 0;
+    String8 string = String8FromCString(str);
+    u8 *end = string.str + string.size;
+    for(u8 *p = string.str; p < end; ++p)
+    {
+        if(ParseIsNumberStart(p, end, 1))
+        {
+            ParseF32(S8(p, end - p), &result);
+            break;
+        }
+    }
+    return result;
+}
+
+//~ NOTE(rjf): Number Formatting
+
+// NOTE(rjf): Formatters write into a caller buffer and return the number of
+// bytes written, with no terminator; FORMAT_*_MAX is the most any of them
+// writes. The PushString* versions write into an arena, and push only what
+// they use (plus a NUL, like PushStringF).
+
+#define FORMAT_INTEGER_MAX 20
+#define FORMAT_FLOAT_MAX   32
+
+global char global_format_digit_pairs[] =
+"00010203040506070809"
+"10111213141516171819"
+"20212223242526272829"
+"30313233343536373839"
+"40414243444546474849"
+"50515253545556575859"
+"60616263646566676869"
+"70717273747576777879"
+"80818283848586878889"
+"90919293949596979899";
+
+global u64 global_format_powers_of_ten[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+internal u32
+FormatDigitCountU64(u64 value)
+{
+    // NOTE(rjf): log10(2) ~= 1233/4096 turns the bit length into a digit
+    // count that is at most one too high.
+    u32 guess = ((HighestSetBitU64(value | 1) + 1) * 1233) >> 12;
+    u32 count = guess - (value < global_format_powers_of_ten[guess]) + 1;
+    return count + (value == 0);
+}
+
+// NOTE(rjf): Writes exactly digit_count digits, ending at buffer + digit_count,
+// two at a time from the end.
+internal void
+FormatDigitsU64(u8 *buffer, u64 value, u32 digit_count)
+{
+    u8 *end = buffer + digit_count;
+    while(value >= 100)
+    {
+        u64 pair = (value % 100)*2;
+        value /= 100;
+        *--end = global_format_digit_pairs[pair + 1];
+        *--end = global_format_digit_pairs[pair];
+    }
+    if(value >= 10)
+    {
+        *--end = global_format_digit_pairs[value*2 + 1];
+        *--end = global_format_digit_pairs[value*2];
+    }
+    else
+    {
+        *--end = (u8)('0' + value);
+    }
+}
+
+internal u64
+FormatU64(u8 *buffer, u64 value)
+{
+    u32 digit_count = FormatDigitCountU64(value);
+    FormatDigitsU64(buffer, value, digit_count);
+    return digit_count;
+}
+
+internal u64
+FormatI64(u8 *buffer, i64 value)
+{
+    u64 size = 0;
+    u64 magnitude = (u64)value;
+    if(value < 0)
+    {
+        buffer[size++] = '-';
+        magnitude = 0 - magnitude;
+    }
+    return size + FormatU64(buffer + size, magnitude);
+}
+
+// NOTE(rjf): Lowercase, no prefix, at least min_digits digits.
+internal u64
+FormatHexU64(u8 *buffer, u64 value, u32 min_digits)
+{
+    u32 digit_count = HighestSetBitU64(value | 1) / 4 + 1;
+    digit_count = Max(digit_count, Min(min_digits, 16));
+    for(u32 i = 0; i < digit_count; ++i)
+    {
+        buffer[digit_count - 1 - i] = "0123456789abcdef"[(value >> (4*i)) & 15];
+    }
+    return digit_count;
+}
+
+// NOTE(rjf): Ryu (Ulf Adams, 2018) lookup tables: 5^-i and 5^i as 125-bit
+// fixed point values, stored as {low 64 bits, high 64 bits}.
+#define FORMAT_POW5_INV_BITCOUNT 125
+#define FORMAT_POW5_BITCOUNT     125
+
+global u64 global_format_pow5_inv_split[342][2] =
+{
+    { 0x0000000000000001ull, 0x2000000000000000ull },
+    { 0x999999999999999aull, 0x1999999999999999ull },
+    { 0x47ae147ae147ae15ull, 0x147ae147ae147ae1ull },
+    { 0x6c8b4395810624deull, 0x10624dd2f1a9fbe7ull },
+    { 0x7a786c226809d496ull, 0x1a36e2eb1c432ca5ull },
+    { 0x61f9f01b866e43abull, 0x14f8b588e368f084ull },
+    { 0xb4c7f34938583622ull, 0x10c6f7a0b5ed8d36ull },
+    { 0x87a6520ec08d236aull, 0x1ad7f29abcaf4857ull },
+    { 0x9fb841a566d74f88ull, 0x15798ee2308c39dfull },
+    { 0xe62d01511f12a607ull, 0x112e0be826d694b2ull },
+    { 0xd6ae6881cb5109a4ull, 0x1b7cdfd9d7bdbab7ull },
+    { 0xdef1ed34a2a73aeaull, 0x15fd7fe17964955full },
+    { 0x7f27f0f6e885c8bbull, 0x119799812dea1119ull },
+    { 0x650cb4be40d60df8ull, 0x1c25c268497681c2ull },
+    { 0xea70909833de7193ull, 0x16849b86a12b9b01ull },
+    { 0x21f3a6e0297ec143ull, 0x1203af9ee756159bull },
+    { 0x6985d7cd0f313537ull, 0x1cd2b297d889bc2bull },
+    { 0x2137dfd73f5a90f9ull, 0x170ef54646d49689ull },
+    { 0xe75fe645cc4873faull, 0x12725dd1d243aba0ull },
+    { 0xa5663d3c7a0d865dull, 0x1d83c94fb6d2ac34ull },
+    { 0x511e976394d79eb1ull, 0x179ca10c9242235dull },
+    { 0xda7edf82dd794bc1ull, 0x12e3b40a0e9b4f7dull },
+    { 0x2a6498d1625bac68ull, 0x1e392010175ee596ull },
+    { 0xeeb6e0a781e2f053ull, 0x182db34012b25144ull },
+    { 0x58924d52ce4f26a9ull, 0x1357c299a88ea76aull },
+    { 0x27507bb7b07ea441ull, 0x1ef2d0f5da7dd8aaull },
+    { 0x52a6c95fc0655034ull, 0x18c240c4aecb13bbull },
+    { 0x0eebd44c99eaa690ull, 0x13ce9a36f23c0fc9ull },
+    { 0xb17953adc3110a80ull, 0x1fb0f6be50601941ull },
+    { 0xc12ddc8b02740867ull, 0x195a5efea6b34767ull },
+    { 0x3424b06f3529a052ull, 0x14484bfeebc29f86ull },
+    { 0x901d59f290ee19dbull, 0x1039d66589687f9eull },
+    { 0x4cfbc31db4b0295full, 0x19f623d5a8a73297ull },
+    { 0x3d9635b15d59bab2ull, 0x14c4e977ba1f5bacull },
+    { 0x97ab5e277de16228ull, 0x109d8792fb4c4956ull },
+    { 0xf2abc9d8c9689d0dull, 0x1a95a5b7f87a0ef0ull },
+    { 0x5bbca17a3aba173eull, 0x154484932d2e725aull },
+    { 0xafca1ac82efb45cbull, 0x11039d428a8b8eaeull },
+    { 0xb2dcf7a6b1920945ull, 0x1b38fb9daa78e44aull },
+    { 0xf57d92ebc141a104ull, 0x15c72fb1552d836eull },
+    { 0xc46475896767b403ull, 0x116c262777579c58ull },
+    { 0x6d6d88dbd8a5ecd2ull, 0x1be03d0bf225c6f4ull },
+    { 0x8abe071646eb23dbull, 0x164cfda3281e38c3ull },
+    { 0x6efe6c11d255b649ull, 0x11d7314f534b609cull },
+    { 0xb197134fb6ef8a0eull, 0x1c8b821885456760ull },
+    { 0x27ac0f72f8bfa1a5ull, 0x16d601ad376ab91aull },
+    { 0xb95672c260994e1eull, 0x1244ce242c5560e1ull },
+    { 0xf5571e03cdc21695ull, 0x1d3ae36d13bbce35ull },
+    { 0x2aac18030b01ababull, 0x17624f8a762fd82bull },
+    { 0xbbbce0026f348956ull, 0x12b50c6ec4f31355ull },
+    { 0x92c7ccd0b1eda889ull, 0x1dee7a4ad4b81eefull },
+    { 0xdbd30a408e57ba07ull, 0x17f1fb6f10934bf2ull },
+    { 0x7ca8d50071dfc806ull, 0x1327fc58da0f6ff5ull },
+    { 0xfaa7bb33e9660cd6ull, 0x1ea6608e29b24cbbull },
+    { 0x9552fc298784d711ull, 0x18851a0b548ea3c9ull },
+    { 0xaaa8c9bad2d0ac0eull, 0x139dae6f76d88307ull },
+    { 0xdddadc5e1e1aace3ull, 0x1f62b0b257c0d1a5ull },
+    { 0x7e48b04b4b488a4full, 0x191bc08eac9a4151ull },
+    { 0xcb6d59d5d5d3a1d9ull, 0x141633a556e1cddaull },
+    { 0x3c577b1177dc817bull, 0x1011c2eaabe7d7e2ull },
+    { 0xc6f25e825960cf2aull, 0x19b604aaaca62636ull },
+    { 0x6bf518684780a5bbull, 0x14919d5556eb51c5ull },
+    { 0x232a79ed06008496ull, 0x10747ddddf22a7d1ull },
+    { 0xd1dd8fe1a3340756ull, 0x1a53fc9631d10c81ull },
+    { 0xa7e4731ae8f66c45ull, 0x150ffd44f4a73d34ull },
+    { 0x531d28e253f8569eull, 0x10d9976a5d52975dull },
+    { 0xeb61db03b98d5762ull, 0x1af5bf109550f22eull },
+    { 0xbc4e48cfc7a445e8ull, 0x159165a6ddda5b58ull },
+    { 0x6371d3d96c836b20ull, 0x11411e1f17e1e2adull },
+    { 0x9f1c8628ad9f11cdull, 0x1b9b6364f3030448ull },
+    { 0xe5b06b53be18db0bull, 0x1615e91d8f359d06ull },
+    { 0xeaf3890fcb4715a2ull, 0x11ab20e472914a6bull },
+    { 0x44b8db4c7871bc37ull, 0x1c45016d841baa46ull },
+    { 0x03c715d6c6c1635full, 0x169d9abe03495505ull },
+    { 0x3638de456bcde919ull, 0x1217aefe69077737ull },
+    { 0x56c163a2461641c1ull, 0x1cf2b1970e725858ull },
+    { 0xdf011c81d1ab67ceull, 0x17288e1271f51379ull },
+    { 0x7f3416ce4155eca5ull, 0x1286d80ec190dc61ull },
+    { 0x6520247d3556476eull, 0x1da48ce468e7c702ull },
+    { 0xea801d30f7783925ull, 0x17b6d71d20b96c01ull },
+    { 0xbb99b0f3f92cfa84ull, 0x12f8ac174d612334ull },
+    { 0x5f5c4e532847f739ull, 0x1e5aacf215683854ull },
+    { 0x7f7d0b75b9d32c2eull, 0x18488a5b44536043ull },
+    { 0x9930d5f7c7dc2358ull, 0x136d3b7c36a919cfull },
+    { 0x8eb4898c72f9d226ull, 0x1f152bf9f10e8fb2ull },
+    { 0x722a07a38f2e41b8ull, 0x18ddbcc7f40ba628ull },
+    { 0xc1bb394fa5be9afaull, 0x13e497065cd61e86ull },
+    { 0x9c5ec2190930f7f6ull, 0x1fd424d6faf030d7ull },
+    { 0x49e56814075a5ff8ull, 0x197683df2f268d79ull },
+    { 0x6e51201005e1e660ull, 0x145ecfe5bf520ac7ull },
+    { 0xf1da800cd181851aull, 0x104bd984990e6f05ull },
+    { 0x4fc400148268d4f5ull, 0x1a12f5a0f4e3e4d6ull },
+    { 0xd96999aa01ed772bull, 0x14dbf7b3f71cb711ull },
+    { 0xadee1488018ac5bcull, 0x10aff95cc5b09274ull },
+    { 0x497ceda668de092cull, 0x1ab328946f80ea54ull },
+    { 0x3aca57b853e4d424ull, 0x155c2076bf9a5510ull },
+    { 0x623b7960431d7683ull, 0x1116805effaeaa73ull },
+    { 0x9d2bf566d1c8bd9eull, 0x1b5733cb32b110b8ull },
+    { 0x7dbcc452416d647full, 0x15df5ca28ef40d60ull },
+    { 0xcafd69db678ab6ccull, 0x117f7d4ed8c33de6ull },
+    { 0xab2f0fc572778adfull, 0x1bff2ee48e052fd7ull },
+    { 0x88f273045b92d580ull, 0x1665bf1d3e6a8cacull },
+    { 0xd3f528d049424466ull, 0x11eaff4a98553d56ull },
+    { 0xb988414d4203a0a3ull, 0x1cab3210f3bb9557ull },
+    { 0x6139cdd76802e6e9ull, 0x16ef5b40c2fc7779ull },
+    { 0xe761717920025254ull, 0x125915cd68c9f92dull },
+    { 0xa568b58e999d5086ull, 0x1d5b561574765b7cull },
+    { 0x5120913ee14aa6d2ull, 0x177c44ddf6c515fdull },
+    { 0xa74d40ff1aa21f0eull, 0x12c9d0b1923744caull },
+    { 0x0baece64f769cb4aull, 0x1e0fb44f50586e11ull },
+    { 0x3c8bd850c5ee3c3bull, 0x180c903f7379f1a7ull },
+    { 0xca0979da37f1c9c9ull, 0x133d4032c2c7f485ull },
+    { 0xa9a8c2f6bfe942dbull, 0x1ec866b79e0cba6full },
+    { 0x2153cf2bccba9be3ull, 0x18a0522c7e709526ull },
+    { 0x1aa9728970954982ull, 0x13b374f06526ddb8ull },
+    { 0xf775840f1a88759dull, 0x1f8587e7083e2f8cull },
+    { 0x5f9136727ba05e17ull, 0x19379fec0698260aull },
+    { 0x1940f85b9619e4dfull, 0x142c7ff0054684d5ull },
+    { 0xe100c6afab47ea4cull, 0x1023998cd1053710ull },
+    { 0xce67a44c453fdd47ull, 0x19d28f47b4d524e7ull },
+    { 0xd852e9d69dccb106ull, 0x14a8729fc3ddb71full },
+    { 0x79dbee454b0a2738ull, 0x1086c219697e2c19ull },
+    { 0x295fe3a211a9d859ull, 0x1a71368f0f30468full },
+    { 0xbab31c81a7bb137aull, 0x15275ed8d8f36ba5ull },
+    { 0x6228e39aec95a92full, 0x10ec4be0ad8f8951ull },
+    { 0x9d0e38f7e0ef7517ull, 0x1b13ac9aaf4c0ee8ull },
+    { 0xb0d82d931a592a79ull, 0x15a956e225d67253ull },
+    { 0x8d79be0f4847552eull, 0x11544581b7dec1dcull },
+    { 0x158f967eda0bbb7cull, 0x1bba08cf8c979c94ull },
+    { 0x77a611ff14d62f97ull, 0x162e6d72d6dfb076ull },
+    { 0xf951a7ff43de8c79ull, 0x11bebdf578b2f391ull },
+    { 0xc21c3ffed2fdad8eull, 0x1c6463225ab7ec1cull },
+    { 0x01b0333242648ad8ull, 0x16b6b5b5155ff017ull },
+    { 0x0159c28e9b83a246ull, 0x122bc490dde659acull },
+    { 0xcef604175f3903a3ull, 0x1d12d41afca3c2acull },
+    { 0x725e69ac4c2d9c83ull, 0x17424348ca1c9bbdull },
+    { 0xf5185489d68ae39cull, 0x129b69070816e2fdull },
+    { 0xee8d540fbdab05c6ull, 0x1dc574d80cf16b2full },
+    { 0xbed77672fe226b05ull, 0x17d12a4670c1228cull },
+    { 0xff12c528cb4ebc04ull, 0x130dbb6b8d674ed6ull },
+    { 0xcb513b74787df9a0ull, 0x1e7c5f127bd87e24ull },
+    { 0x090dc929f9fe614dull, 0x18637f41fcad31b7ull },
+    { 0xa0d7d42194cb810aull, 0x1382cc34ca2427c5ull },
+    { 0x67bfb9cf5478ce77ull, 0x1f37ad21436d0c6full },
+    { 0x1fcc94a5dd2d71f9ull, 0x18f9574dcf8a7059ull },
+    { 0x7fd6dd517dbdf4c7ull, 0x13faac3e3fa1f37aull },
+    { 0xffbe2ee8c92fee0bull, 0x1ff779fd329cb8c3ull },
+    { 0x6631bf20a0f324d6ull, 0x1992c7fdc216fa36ull },
+    { 0xb827cc1a1a5c1d78ull, 0x14756ccb01abfb5eull },
+    { 0x935309ae7b7ce460ull, 0x105df0a267bcc918ull },
+    { 0x1eeb42b0c594a099ull, 0x1a2fe76a3f9474f4ull },
+    { 0xe58902270476e6e1ull, 0x14f31f8832dd2a5cull },
+    { 0xb7a0ce859d2bebe7ull, 0x10c27fa028b0eeb0ull },
+    { 0x59014a6f61dfdfd8ull, 0x1ad0cc33744e4ab4ull },
+    { 0xe0cdd525e7e64cadull, 0x1573d68f903ea229ull },
+    { 0x4d7177518651d6f1ull, 0x11297872d9cbb4eeull },
+    { 0x7be8bee8d6e957e8ull, 0x1b758d848fac54b0ull },
+    { 0xfcba3253df211320ull, 0x15f7a46a0c89dd59ull },
+    { 0x63c8284318e74280ull, 0x1192e9ee706e4aaeull },
+    { 0x060d0d3827d86a66ull, 0x1c1e43171a4a1117ull },
+    { 0x6b3da42cecad21ebull, 0x167e9c127b6e7412ull },
+    { 0x88fe1cf0bd574e56ull, 0x11fee341fc585cdbull },
+    { 0x419694b462254a23ull, 0x1ccb0536608d615full },
+    { 0x67abaa29e81dd4e9ull, 0x1708d0f84d3de77full },
+    { 0xb95621bb2017dd87ull, 0x126d73f9d764b932ull },
+    { 0xc223692b668c95a5ull, 0x1d7becc2f23ac1eaull },
+    { 0xce82ba891ed6de1dull, 0x179657025b6234bbull },
+    { 0xa53562074bdf1818ull, 0x12deac01e2b4f6fcull },
+    { 0x3b889cd87964f359ull, 0x1e3113363787f194ull },
+    { 0xfc6d4a46c783f5e1ull, 0x18274291c6065adcull },
+    { 0x30576e9f06032b1aull, 0x13529ba7d19eaf17ull },
+    { 0x1a257dcb3cd1de90ull, 0x1eea92a61c311825ull },
+    { 0x481dfe3c30a7e540ull, 0x18bba884e35a79b7ull },
+    { 0xd34b31c9c0865100ull, 0x13c9539d82aec7c5ull },
+    { 0x5211e942cda3b4cdull, 0x1fa885c8d117a609ull },
+    { 0x74db21023e1c90a4ull, 0x19539e3a40dfb807ull },
+    { 0xf715b401cb4a0d50ull, 0x1442e4fb67196005ull },
+    { 0xf8de299b09080aa7ull, 0x103583fc527ab337ull },
+    { 0x8e304291a80cddd7ull, 0x19ef3993b72ab859ull },
+    { 0x3e8d020e200a4b13ull, 0x14bf6142f8eef9e1ull },
+    { 0x653d9b3e80083c0full, 0x10991a9bfa58c7e7ull },
+    { 0x6ec8f864000d2ce4ull, 0x1a8e90f9908e0ca5ull },
+    { 0x8bd3f9e999a423eaull, 0x153eda614071a3b7ull },
+    { 0x3ca994bae1501cbbull, 0x10ff151a99f482f9ull },
+    { 0xc775bac49bb3612bull, 0x1b31bb5dc320d18eull },
+    { 0xd2c4956a16291a89ull, 0x15c162b168e70e0bull },
+    { 0xdbd0778811ba7ba1ull, 0x11678227871f3e6full },
+    { 0x2c80bf401c5d929bull, 0x1bd8d03f3e9863e6ull },
+    { 0xbd33cc3349e47549ull, 0x16470cff6546b651ull },
+    { 0xca8fd68f6e505dd4ull, 0x11d270cc51055ea7ull },
+    { 0x4419574be3b3c953ull, 0x1c83e7ad4e6efdd9ull },
+    { 0x0347790982f63aa9ull, 0x16cfec8aa52597e1ull },
+    { 0xcf6c60d468c4fbbaull, 0x123ff06eea847980ull },
+    { 0xe57a34870e07f92aull, 0x1d331a4b10d3f59aull },
+    { 0x512e906c0b399422ull, 0x175c1508da432ae2ull },
+    { 0xda8ba6bcd5c7a9b5ull, 0x12b010d3e1cf5581ull },
+    { 0x90df712e22d90f87ull, 0x1de6815302e5559cull },
+    { 0xda4c5a8b4f140c6cull, 0x17eb9aa8cf1dde16ull },
+    { 0xaea37ba2a5a9a38aull, 0x1322e220a5b17e78ull },
+    { 0x7dd25f6aa2a905a9ull, 0x1e9e369aa2b59727ull },
+    { 0x97db7f888220d154ull, 0x187e92154ef7ac1full },
+    { 0x797c6606ce80a777ull, 0x139874ddd8c6234cull },
+    { 0x8f2d700ae4010bf1ull, 0x1f5a549627a36badull },
+    { 0x0c2459a25000d65aull, 0x191510781fb5efbeull },
+    { 0x701d1481d99a4515ull, 0x1410d9f9b2f7f2feull },
+    { 0xc017439b147b6a77ull, 0x100d7b2e28c65bfeull },
+    { 0xccf205c4ed9243f2ull, 0x19af2b7d0e0a2ccaull },
+    { 0x0a5b37d0be0e9cc2ull, 0x148c22ca71a1bd6full },
+    { 0x0848f973cb3ee3ceull, 0x10701bd527b4978cull },
+    { 0xda0e5bec78649fb0ull, 0x1a4cf9550c5425acull },
+    { 0x7b3eaff060507fc0ull, 0x150a6110d6a9b7bdull },
+    { 0x95cbbff380406633ull, 0x10d51a73deee2c97ull },
+    { 0xefac665266cd7052ull, 0x1aee90b964b04758ull },
+    { 0x2623850eb8a459dbull, 0x158ba6fab6f36c47ull },
+    { 0x1e82d0d893b6ae49ull, 0x113c85955f29236cull },
+    { 0xfd9e1af41f8ab075ull, 0x1b9408eefea838acull },
+    { 0x97b1af29b2d559f7ull, 0x16100725988693bdull },
+    { 0xac8e25baf5777b2cull, 0x11a66c1e139edc97ull },
+    { 0x7a7d092b2258c513ull, 0x1c3d79c9b8fe2dbfull },
+    { 0x61fda0ef4ead6a76ull, 0x169794a160cb57ccull },
+    { 0xe7fe1a590bbdeec5ull, 0x1212dd4de7091309ull },
+    { 0xa6635d5b45fcb13aull, 0x1ceafbafd80e84dcull },
+    { 0x851c4aaf6b308dc8ull, 0x172262f3133ed0b0ull },
+    { 0xd0e36ef2bc26d7d4ull, 0x1281e8c275cbda26ull },
+    { 0xb49f17eac6a48c86ull, 0x1d9ca79d894629d7ull },
+    { 0x2a18dfef0550706bull, 0x17b08617a104ee46ull },
+    { 0x54e0b3259dd9f389ull, 0x12f39e794d9d8b6bull },
+    { 0x87cdeb6f62f65274ull, 0x1e5297287c2f4578ull },
+    { 0xd30b22bf825ea85dull, 0x18421286c9bf6ac6ull },
+    { 0x0f3c1bcc684bb9e4ull, 0x13680ed23aff889full },
+    { 0x18602c7a4079296dull, 0x1f0ce4839198da98ull },
+    { 0x46b356c833942124ull, 0x18d71d360e13e213ull },
+    { 0x388f78a029434db6ull, 0x13df4a91a4dcb4dcull },
+    { 0x5a7f2766a86baf8aull, 0x1fcbaa82a1612160ull },
+    { 0x153285ebb9efbfa2ull, 0x196fbb9bb44db44dull },
+    { 0xaa8ed189618c994eull, 0x145962e2f6a4903dull },
+    { 0xeed8a7a11ad6e10cull, 0x1047824f2bb6d9caull },
+    { 0x7e27729b5e249b45ull, 0x1a0c03b1df8af611ull },
+    { 0xfe85f549181d4904ull, 0x14d6695b193bf80dull },
+    { 0xcb9e5dd4134aa0d0ull, 0x10ab877c142ff9a4ull },
+    { 0xdf63c9535211014dull, 0x1aac0bf9b9e65c3aull },
+    { 0x191ca10f74da6771ull, 0x15566ffafb1eb02full },
+    { 0xadb080d92a4852c1ull, 0x1111f32f2f4bc025ull },
+    { 0x15e7348eaa0d5134ull, 0x1b4feb7eb212cd09ull },
+    { 0xab1f5d3eee710dc4ull, 0x15d98932280f0a6dull },
+    { 0xbc1917658b8da49dull, 0x117ad428200c0857ull },
+    { 0x2cf4f23c127c3a94ull, 0x1bf7b9d9cce00d59ull },
+    { 0xf0c3f4fcdb969543ull, 0x165fc7e170b33de0ull },
+    { 0x5a365d9716121103ull, 0x11e6398126f5cb1aull },
+    { 0x9056fc24f01ce804ull, 0x1ca38f350b22de90ull },
+    { 0xd9df301d8ce3ecd0ull, 0x16e93f5da2824ba6ull },
+    { 0xe17f59b13d8323daull, 0x125432b14ecea2ebull },
+    { 0x68cbc2b52f38395cull, 0x1d53844ee47dd179ull },
+    { 0x53d6355dbf602de3ull, 0x177603725064a794ull },
+    { 0xa9782ab165e68b1cull, 0x12c4cf8ea6b6ec76ull },
+    { 0x0f26aab56fd744faull, 0x1e07b27dd78b13f1ull },
+    { 0x3f52222abfdf6a62ull, 0x18062864ac6f4327ull },
+    { 0x65db4e88997f884eull, 0x1338205089f29c1full },
+    { 0x6fc54a7428cc0d4aull, 0x1ec033b40fea9365ull },
+    { 0x596aa1f68709a43bull, 0x1899c2f673220f84ull },
+    { 0xadeee7f86c07b696ull, 0x13ae3591f5b4d936ull },
+    { 0x497e3ff3e00c5756ull, 0x1f7d228322baf524ull },
+    { 0xd464fff64cd6ac45ull, 0x1930e868e89590e9ull },
+    { 0x4383fff83d7889d1ull, 0x14272053ed4473eeull },
+    { 0xcf9cccc69793a174ull, 0x101f4d0ff1038ff1ull },
+    { 0x7f6147a425b90252ull, 0x19cbae7fe805b31cull },
+    { 0xcc4dd2e9b7c7350full, 0x14a2f1ffecd15c16ull },
+    { 0x3d0b0f215fd290d9ull, 0x10825b3323dab012ull },
+    { 0x61ab4b689950e7c1ull, 0x1a6a2b85062ab350ull },
+    { 0x4e22a2ba1440b967ull, 0x1521bc6a6b555c40ull },
+    { 0x0b4ee894dd009453ull, 0x10e7c9eebc4449cdull },
+    { 0x1217da87c800ed51ull, 0x1b0c764ac6d3a948ull },
+    { 0xdb46486ca000bddaull, 0x15a391d56bdc876cull },
+    { 0x490506bd4ccd64afull, 0x114fa7ddefe39f8aull },
+    { 0xa8080ac87ae23ab1ull, 0x1bb2a62fe638ff43ull },
+    { 0x5339a239fbe82ef4ull, 0x162884f31e93ff69ull },
+    { 0x75c7b4fb2fecf25dull, 0x11ba03f5b20fff87ull },
+    { 0x22d92191e647ea2eull, 0x1c5cd322b67fff3full },
+    { 0xb57a8141850654f2ull, 0x16b0a8e891ffff65ull },
+    { 0xc4620101373843f5ull, 0x1226ed86db3332b7ull },
+    { 0x3a366801f1f39feeull, 0x1d0b15a491eb8459ull },
+    { 0xfb5eb99b27f6198bull, 0x173c115074bc69e0ull },
+    { 0x2f7efae2865e7ad6ull, 0x129674405d6387e7ull },
+    { 0xe597f7d0d6fd9156ull, 0x1dbd86cd6238d971ull },
+    { 0x8479930d78cadaabull, 0x17cad23de82d7ac1ull },
+    { 0xd06142712d6f1556ull, 0x1308a831868ac89aull },
+    { 0x4d686a4eaf182222ull, 0x1e74404f3daada91ull },
+    { 0xa453883ef279b4e8ull, 0x185d003f6488aedaull },
+    { 0xe9dc6cff28615d87ull, 0x137d99cc506d58aeull },
+    { 0xa960ae650d6895a4ull, 0x1f2f5c7a1a488de4ull },
+    { 0xbab3beb73ded4483ull, 0x18f2b061aea07183ull },
+    { 0x2ef6322c318a9d36ull, 0x13f559e7bee6c136ull },
+    { 0xe4bd1d13827761f0ull, 0x1feef63f97d79b89ull },
+    { 0x83ca7da9352c4e5aull, 0x198bf832dfdfafa1ull },
+    { 0x9ca1fe20f756a515ull, 0x146ff9c24cb2f2e7ull },
+    { 0x4a1b31b3f9121daaull, 0x1059949b708f28b9ull },
+    { 0x435eb5ecc1b695ddull, 0x1a28edc580e50df5ull },
+    { 0x35e55e57015ede4aull, 0x14ed8b04671da4c4ull },
+    { 0xc4b77eac0118b1d5ull, 0x10be08d0527e1d69ull },
+    { 0xa12597799b5ab622ull, 0x1ac9a7b3b7302f0full },
+    { 0x4db7ac6149155e81ull, 0x156e1fc2f8f358d9ull },
+    { 0xd7c6238107444b9bull, 0x1124e63593f5e0adull },
+    { 0x593d059b3ed3ac2bull, 0x1b6e3d2286563449ull },
+    { 0xe0fd9e15cbdc89bcull, 0x15f1ca820511c36dull },
+    { 0xb3fe18116fe3a163ull, 0x118e3b9b37416924ull },
+    { 0x866359b57fd29bd1ull, 0x1c16c5c525357507ull },
+    { 0xd1e91491330ee30eull, 0x16789e3750f790d2ull },
+    { 0x74ba76da8f3f1c0bull, 0x11fa182c40c60d75ull },
+    { 0xedf72490e531c678ull, 0x1cc359e067a348bbull },
+    { 0x8b2c1d40b75b052dull, 0x1702ae4d1fb5d3c9ull },
+    { 0x6f567dcd5f7c0424ull, 0x12688b70e62b0fd4ull },
+    { 0x7ef0c94898c66d06ull, 0x1d74124e3d11b2edull },
+    { 0x98c0a106e09ebd9full, 0x17900ea4fda7c257ull },
+    { 0x470080d24d4bcae6ull, 0x12d9a550caec9b79ull },
+    { 0xd800ce1d487944a2ull, 0x1e29088144adc58eull },
+    { 0x1333d8176d2dd082ull, 0x1820d39a9d57d13full },
+    { 0xa8f646792424a6ceull, 0x134d76154aaca765ull },
+    { 0x74bd3d8ea03aa47dull, 0x1ee25688777aa56full },
+    { 0x5d64313ee6955064ull, 0x18b51206c5fbb78cull },
+    { 0x4ab68dcbebaaa6b7ull, 0x13c40e6bd1962c70ull },
+    { 0x1124161312aaa457ull, 0x1fa01712e8f0471aull },
+    { 0xda8344dc0eeee9dfull, 0x194cdf4253f36c14ull },
+    { 0xe2029d7cd8bf2180ull, 0x143d7f6843292343ull },
+    { 0x4e687dfd7a328133ull, 0x103132b9cf541c36ull },
+    { 0x4a40c9959050ceb8ull, 0x19e851294bb9c6bdull },
+    { 0x0833d477a6a70bc6ull, 0x14b9da876fc7d231ull },
+    { 0xa02976c61eec096bull, 0x1094aed2bfd30e8dull },
+    { 0x004257a364acdbdfull, 0x1a877e1dffb81749ull },
+    { 0xcd01dfb5ea23e319ull, 0x153931b1996012a0ull },
+    { 0x70ce4c91881cb5aeull, 0x10fa8e27ade6754dull },
+    { 0x1ae3adb5a69455e2ull, 0x1b2a7d0c4970bbafull },
+    { 0x7be957c4854377e8ull, 0x15bb973d078d62f2ull },
+    { 0xc987796a0435f987ull, 0x1162df64060ab58eull },
+    { 0x75a58f1006bcc271ull, 0x1bd1656cd67788e4ull },
+    { 0xf7b7a5a66bca3527ull, 0x16411df0ab92d3e9ull },
+    { 0x5fc61e1ebca1c41full, 0x11cdb18d560f0feeull },
+    { 0xffa363646102d365ull, 0x1c7c4f4889b1b316ull },
+    { 0x32e91c504d9bdc51ull, 0x16c9d906d48e28dfull },
+    { 0x8f20e37371497d0eull, 0x123b140576d820b2ull },
+    { 0x7e9b0585820f2e7cull, 0x1d2b533bf159cdeaull },
+    { 0xcbaf379e01a5becaull, 0x1755dc2ff447d7eeull },
+    { 0x0958f94b348498a1ull, 0x12ab168cc36cacbfull },
+};
+
+global u64 global_format_pow5_split[326][2] =
+{
+    { 0x0000000000000000ull, 0x1000000000000000ull },
+    { 0x0000000000000000ull, 0x1400000000000000ull },
+    { 0x0000000000000000ull, 0x1900000000000000ull },
+    { 0x0000000000000000ull, 0x1f40000000000000ull },
+    { 0x0000000000000000ull, 0x1388000000000000ull },
+    { 0x0000000000000000ull, 0x186a000000000000ull },
+    { 0x0000000000000000ull, 0x1e84800000000000ull },
+    { 0x0000000000000000ull, 0x1312d00000000000ull },
+    { 0x0000000000000000ull, 0x17d7840000000000ull },
+    { 0x0000000000000000ull, 0x1dcd650000000000ull },
+    { 0x0000000000000000ull, 0x12a05f2000000000ull },
+    { 0x0000000000000000ull, 0x174876e800000000ull },
+    { 0x0000000000000000ull, 0x1d1a94a200000000ull },
+    { 0x0000000000000000ull, 0x12309ce540000000ull },
+    { 0x0000000000000000ull, 0x16bcc41e90000000ull },
+    { 0x0000000000000000ull, 0x1c6bf52634000000ull },
+    { 0x0000000000000000ull, 0x11c37937e0800000ull },
+    { 0x0000000000000000ull, 0x16345785d8a00000ull },
+    { 0x0000000000000000ull, 0x1bc16d674ec80000ull },
+    { 0x0000000000000000ull, 0x1158e460913d0000ull },
+    { 0x0000000000000000ull, 0x15af1d78b58c4000ull },
+    { 0x0000000000000000ull, 0x1b1ae4d6e2ef5000ull },
+    { 0x0000000000000000ull, 0x10f0cf064dd59200ull },
+    { 0x0000000000000000ull, 0x152d02c7e14af680ull },
+    { 0x0000000000000000ull, 0x1a784379d99db420ull },
+    { 0x0000000000000000ull, 0x108b2a2c28029094ull },
+    { 0x0000000000000000ull, 0x14adf4b7320334b9ull },
+    { 0x4000000000000000ull, 0x19d971e4fe8401e7ull },
+    { 0x8800000000000000ull, 0x1027e72f1f128130ull },
+    { 0xaa00000000000000ull, 0x1431e0fae6d7217cull },
+    { 0xd480000000000000ull, 0x193e5939a08ce9dbull },
+    { 0xc9a0000000000000ull, 0x1f8def8808b02452ull },
+    { 0xbe04000000000000ull, 0x13b8b5b5056e16b3ull },
+    { 0xad85000000000000ull, 0x18a6e32246c99c60ull },
+    { 0xd8e6400000000000ull, 0x1ed09bead87c0378ull },
+    { 0x878fe80000000000ull, 0x13426172c74d822bull },
+    { 0x6973e20000000000ull, 0x1812f9cf7920e2b6ull },
+    { 0x03d0da8000000000ull, 0x1e17b84357691b64ull },
+    { 0x8262889000000000ull, 0x12ced32a16a1b11eull },
+    { 0x22fb2ab400000000ull, 0x178287f49c4a1d66ull },
+    { 0xabb9f56100000000ull, 0x1d6329f1c35ca4bfull },
+    { 0xcb54395ca0000000ull, 0x125dfa371a19e6f7ull },
+    { 0xbe2947b3c8000000ull, 0x16f578c4e0a060b5ull },
+    { 0x2db399a0ba000000ull, 0x1cb2d6f618c878e3ull },
+    { 0xfc90400474400000ull, 0x11efc659cf7d4b8dull },
+    { 0x7bb4500591500000ull, 0x166bb7f0435c9e71ull },
+    { 0xdaa16406f5a40000ull, 0x1c06a5ec5433c60dull },
+    { 0xa8a4de8459868000ull, 0x118427b3b4a05bc8ull },
+    { 0xd2ce16256fe82000ull, 0x15e531a0a1c872baull },
+    { 0x87819baecbe22800ull, 0x1b5e7e08ca3a8f69ull },
+    { 0xf4b1014d3f6d5900ull, 0x111b0ec57e6499a1ull },
+    { 0x71dd41a08f48af40ull, 0x1561d276ddfdc00aull },
+    { 0x0e549208b31adb10ull, 0x1aba4714957d300dull },
+    { 0x28f4db456ff0c8eaull, 0x10b46c6cdd6e3e08ull },
+    { 0x33321216cbecfb24ull, 0x14e1878814c9cd8aull },
+    { 0xbffe969c7ee839edull, 0x1a19e96a19fc40ecull },
+    { 0xf7ff1e21cf512434ull, 0x105031e2503da893ull },
+    { 0xf5fee5aa43256d41ull, 0x14643e5ae44d12b8ull },
+    { 0x337e9f14d3eec892ull, 0x197d4df19d605767ull },
+    { 0x005e46da08ea7ab6ull, 0x1fdca16e04b86d41ull },
+    { 0xa03aec4845928cb2ull, 0x13e9e4e4c2f34448ull },
+    { 0xc849a75a56f72fdeull, 0x18e45e1df3b0155aull },
+    { 0x7a5c1130ecb4fbd6ull, 0x1f1d75a5709c1ab1ull },
+    { 0xec798abe93f11d65ull, 0x13726987666190aeull },
+    { 0xa797ed6e38ed64bfull, 0x184f03e93ff9f4daull },
+    { 0x517de8c9c728bdefull, 0x1e62c4e38ff87211ull },
+    { 0xd2eeb17e1c7976b5ull, 0x12fdbb0e39fb474aull },
+    { 0x87aa5ddda397d462ull, 0x17bd29d1c87a191dull },
+    { 0xe994f5550c7dc97bull, 0x1dac74463a989f64ull },
+    { 0x11fd195527ce9dedull, 0x128bc8abe49f639full },
+    { 0xd67c5faa71c24568ull, 0x172ebad6ddc73c86ull },
+    { 0x8c1b77950e32d6c2ull, 0x1cfa698c95390ba8ull },
+    { 0x57912abd28dfc639ull, 0x121c81f7dd43a749ull },
+    { 0xad75756c7317b7c8ull, 0x16a3a275d494911bull },
+    { 0x98d2d2c78fdda5baull, 0x1c4c8b1349b9b562ull },
+    { 0x9f83c3bcb9ea8794ull, 0x11afd6ec0e14115dull },
+    { 0x0764b4abe8652979ull, 0x161bcca7119915b5ull },
+    { 0x493de1d6e27e73d7ull, 0x1ba2bfd0d5ff5b22ull },
+    { 0x6dc6ad264d8f0866ull, 0x1145b7e285bf98f5ull },
+    { 0xc938586fe0f2ca80ull, 0x159725db272f7f32ull },
+    { 0x7b866e8bd92f7d20ull, 0x1afcef51f0fb5effull },
+    { 0xad34051767bdae34ull, 0x10de1593369d1b5full },
+    { 0x9881065d41ad19c1ull, 0x15159af804446237ull },
+    { 0x7ea147f492186032ull, 0x1a5b01b605557ac5ull },
+    { 0x6f24ccf8db4f3c1full, 0x1078e111c3556cbbull },
+    { 0x4aee003712230b27ull, 0x14971956342ac7eaull },
+    { 0xdda98044d6abcdf0ull, 0x19bcdfabc13579e4ull },
+    { 0x0a89f02b062b60b6ull, 0x10160bcb58c16c2full },
+    { 0xcd2c6c35c7b638e4ull, 0x141b8ebe2ef1c73aull },
+    { 0x8077874339a3c71dull, 0x1922726dbaae3909ull },
+    { 0xe0956914080cb8e4ull, 0x1f6b0f092959c74bull },
+    { 0x6c5d61ac8507f38eull, 0x13a2e965b9d81c8full },
+    { 0x4774ba17a649f072ull, 0x188ba3bf284e23b3ull },
+    { 0x1951e89d8fdc6c8full, 0x1eae8caef261aca0ull },
+    { 0x0fd3316279e9c3d9ull, 0x132d17ed577d0be4ull },
+    { 0x13c7fdbb186434cfull, 0x17f85de8ad5c4eddull },
+    { 0x58b9fd29de7d4203ull, 0x1df67562d8b36294ull },
+    { 0xb7743e3a2b0e4942ull, 0x12ba095dc7701d9cull },
+    { 0xe5514dc8b5d1db92ull, 0x17688bb5394c2503ull },
+    { 0xdea5a13ae3465277ull, 0x1d42aea2879f2e44ull },
+    { 0x0b2784c4ce0bf38aull, 0x1249ad2594c37cebull },
+    { 0xcdf165f6018ef06dull, 0x16dc186ef9f45c25ull },
+    { 0x416dbf7381f2ac88ull, 0x1c931e8ab871732full },
+    { 0x88e497a83137abd5ull, 0x11dbf316b346e7fdull },
+    { 0xeb1dbd923d8596caull, 0x1652efdc6018a1fcull },
+    { 0x25e52cf6cce6fc7dull, 0x1be7abd3781eca7cull },
+    { 0x97af3c1a40105dceull, 0x1170cb642b133e8dull },
+    { 0xfd9b0b20d0147542ull, 0x15ccfe3d35d80e30ull },
+    { 0x3d01cde904199292ull, 0x1b403dcc834e11bdull },
+    { 0x462120b1a28ffb9bull, 0x1108269fd210cb16ull },
+    { 0xd7a968de0b33fa82ull, 0x154a3047c694fddbull },
+    { 0xcd93c3158e00f923ull, 0x1a9cbc59b83a3d52ull },
+    { 0xc07c59ed78c09bb6ull, 0x10a1f5b813246653ull },
+    { 0xb09b7068d6f0c2a3ull, 0x14ca732617ed7fe8ull },
+    { 0xdcc24c830cacf34cull, 0x19fd0fef9de8dfe2ull },
+    { 0xc9f96fd1e7ec180full, 0x103e29f5c2b18bedull },
+    { 0x3c77cbc661e71e13ull, 0x144db473335deee9ull },
+    { 0x8b95beb7fa60e598ull, 0x1961219000356aa3ull },
+    { 0x6e7b2e65f8f91efeull, 0x1fb969f40042c54cull },
+    { 0xc50cfcffbb9bb35full, 0x13d3e2388029bb4full },
+    { 0xb6503c3faa82a037ull, 0x18c8dac6a0342a23ull },
+    { 0xa3e44b4f95234844ull, 0x1efb1178484134acull },
+    { 0xe66eaf11bd360d2bull, 0x135ceaeb2d28c0ebull },
+    { 0xe00a5ad62c839075ull, 0x183425a5f872f126ull },
+    { 0x980cf18bb7a47493ull, 0x1e412f0f768fad70ull },
+    { 0x5f0816f752c6c8dcull, 0x12e8bd69aa19cc66ull },
+    { 0xf6ca1cb527787b13ull, 0x17a2ecc414a03f7full },
+    { 0xf47ca3e2715699d7ull, 0x1d8ba7f519c84f5full },
+    { 0xf8cde66d86d62026ull, 0x127748f9301d319bull },
+    { 0xf7016008e88ba830ull, 0x17151b377c247e02ull },
+    { 0xb4c1b80b22ae923cull, 0x1cda62055b2d9d83ull },
+    { 0x50f91306f5ad1b65ull, 0x12087d4358fc8272ull },
+    { 0xe53757c8b318623full, 0x168a9c942f3ba30eull },
+    { 0x9e852dbadfde7acfull, 0x1c2d43b93b0a8bd2ull },
+    { 0xa3133c94cbeb0cc1ull, 0x119c4a53c4e69763ull },
+    { 0x8bd80bb9fee5cff1ull, 0x16035ce8b6203d3cull },
+    { 0xaece0ea87e9f43eeull, 0x1b843422e3a84c8bull },
+    { 0x4d40c9294f238a75ull, 0x1132a095ce492fd7ull },
+    { 0x2090fb73a2ec6d12ull, 0x157f48bb41db7bcdull },
+    { 0x68b53a508ba78856ull, 0x1adf1aea12525ac0ull },
+    { 0x417144725748b536ull, 0x10cb70d24b7378b8ull },
+    { 0x51cd958eed1ae283ull, 0x14fe4d06de5056e6ull },
+    { 0xe640faf2a8619b24ull, 0x1a3de04895e46c9full },
+    { 0xefe89cd7a93d00f7ull, 0x1066ac2d5daec3e3ull },
+    { 0xebe2c40d938c4134ull, 0x14805738b51a74dcull },
+    { 0x26db7510f86f5181ull, 0x19a06d06e2611214ull },
+    { 0x9849292a9b4592f1ull, 0x100444244d7cab4cull },
+    { 0xbe5b73754216f7adull, 0x1405552d60dbd61full },
+    { 0xadf25052929cb598ull, 0x1906aa78b912cba7ull },
+    { 0x996ee4673743e2ffull, 0x1f485516e7577e91ull },
+    { 0xffe54ec0828a6ddfull, 0x138d352e5096af1aull },
+    { 0xbfdea270a32d0957ull, 0x18708279e4bc5ae1ull },
+    { 0x2fd64b0ccbf84badull, 0x1e8ca3185deb719aull },
+    { 0x5de5eee7ff7b2f4cull, 0x1317e5ef3ab32700ull },
+    { 0x755f6aa1ff59fb1full, 0x17dddf6b095ff0c0ull },
+    { 0x92b7454a7f3079e7ull, 0x1dd55745cbb7ecf0ull },
+    { 0x5bb28b4e8f7e4c30ull, 0x12a5568b9f52f416ull },
+    { 0xf29f2e22335ddf3cull, 0x174eac2e8727b11bull },
+    { 0xef46f9aac035570bull, 0x1d22573a28f19d62ull },
+    { 0xd58c5c0ab8215667ull, 0x123576845997025dull },
+    { 0x4aef730d6629ac01ull, 0x16c2d4256ffcc2f5ull },
+    { 0x9dab4fd0bfb41701ull, 0x1c73892ecbfbf3b2ull },
+    { 0xa28b11e277d08e60ull, 0x11c835bd3f7d784full },
+    { 0x8b2dd65b15c4b1f9ull, 0x163a432c8f5cd663ull },
+    { 0x6df94bf1db35de77ull, 0x1bc8d3f7b3340bfcull },
+    { 0xc4bbcf772901ab0aull, 0x115d847ad000877dull },
+    { 0x35eac354f34215cdull, 0x15b4e5998400a95dull },
+    { 0x8365742a30129b40ull, 0x1b221effe500d3b4ull },
+    { 0xd21f689a5e0ba108ull, 0x10f5535fef208450ull },
+    { 0x06a742c0f58e894aull, 0x1532a837eae8a565ull },
+    { 0x4851137132f22b9dull, 0x1a7f5245e5a2cebeull },
+    { 0xed32ac26bfd75b42ull, 0x108f936baf85c136ull },
+    { 0xa87f57306fcd3212ull, 0x14b378469b673184ull },
+    { 0xd29f2cfc8bc07e97ull, 0x19e056584240fde5ull },
+    { 0xa3a37c1dd7584f1eull, 0x102c35f729689eafull },
+    { 0x8c8c5b254d2e62e6ull, 0x14374374f3c2c65bull },
+    { 0x6faf71eea079fb9full, 0x1945145230b377f2ull },
+    { 0x0b9b4e6a48987a87ull, 0x1f965966bce055efull },
+    { 0x674111026d5f4c94ull, 0x13bdf7e0360c35b5ull },
+    { 0xc111554308b71fbaull, 0x18ad75d8438f4322ull },
+    { 0x7155aa93cae4e7a8ull, 0x1ed8d34e547313ebull },
+    { 0x26d58a9c5ecf10c9ull, 0x13478410f4c7ec73ull },
+    { 0xf08aed437682d4fbull, 0x1819651531f9e78full },
+    { 0xecada89454238a3aull, 0x1e1fbe5a7e786173ull },
+    { 0x73ec895cb4963664ull, 0x12d3d6f88f0b3ce8ull },
+    { 0x90e7abb3e1bbc3fdull, 0x1788ccb6b2ce0c22ull },
+    { 0x352196a0da2ab4fdull, 0x1d6affe45f818f2bull },
+    { 0x0134fe24885ab11eull, 0x1262dfeebbb0f97bull },
+    { 0xc1823dadaa715d65ull, 0x16fb97ea6a9d37d9ull },
+    { 0x31e2cd19150db4bfull, 0x1cba7de5054485d0ull },
+    { 0x1f2dc02fad2890f7ull, 0x11f48eaf234ad3a2ull },
+    { 0xa6f9303b9872b535ull, 0x1671b25aec1d888aull },
+    { 0x50b77c4a7e8f6282ull, 0x1c0e1ef1a724eaadull },
+    { 0x5272adae8f199d91ull, 0x1188d357087712acull },
+    { 0x670f591a32e004f6ull, 0x15eb082cca94d757ull },
+    { 0x40d32f60bf980633ull, 0x1b65ca37fd3a0d2dull },
+    { 0x4883fd9c77bf03e0ull, 0x111f9e62fe44483cull },
+    { 0x5aa4fd0395aec4d8ull, 0x156785fbbdd55a4bull },
+    { 0x314e3c447b1a760eull, 0x1ac1677aad4ab0deull },
+    { 0xded0e5aaccf089c9ull, 0x10b8e0acac4eae8aull },
+    { 0x96851f15802cac3bull, 0x14e718d7d7625a2dull },
+    { 0xfc2666dae037d74aull, 0x1a20df0dcd3af0b8ull },
+    { 0x9d980048cc22e68eull, 0x10548b68a044d673ull },
+    { 0x84fe005aff2ba032ull, 0x1469ae42c8560c10ull },
+    { 0xa63d8071bef6883eull, 0x198419d37a6b8f14ull },
+    { 0xcfcce08e2eb42a4eull, 0x1fe52048590672d9ull },
+    { 0x21e00c58dd309a70ull, 0x13ef342d37a407c8ull },
+    { 0x2a580f6f147cc10dull, 0x18eb0138858d09baull },
+    { 0xb4ee134ad99bf150ull, 0x1f25c186a6f04c28ull },
+    { 0x7114cc0ec80176d2ull, 0x137798f428562f99ull },
+    { 0xcd59ff127a01d486ull, 0x18557f31326bbb7full },
+    { 0xc0b07ed7188249a8ull, 0x1e6adefd7f06aa5full },
+    { 0xd86e4f466f516e09ull, 0x1302cb5e6f642a7bull },
+    { 0xce89e3180b25c98bull, 0x17c37e360b3d351aull },
+    { 0x822c5bde0def3beeull, 0x1db45dc38e0c8261ull },
+    { 0xf15bb96ac8b58575ull, 0x1290ba9a38c7d17cull },
+    { 0x2db2a7c57ae2e6d2ull, 0x1734e940c6f9c5dcull },
+    { 0x391f51b6d99ba086ull, 0x1d022390f8b83753ull },
+    { 0x03b3931248014454ull, 0x1221563a9b732294ull },
+    { 0x04a077d6da019569ull, 0x16a9abc9424feb39ull },
+    { 0x45c895cc9081fac3ull, 0x1c5416bb92e3e607ull },
+    { 0x8b9d5d9fda513cbaull, 0x11b48e353bce6fc4ull },
+    { 0xae84b507d0e58be8ull, 0x1621b1c28ac20bb5ull },
+    { 0x1a25e249c51eeee3ull, 0x1baa1e332d728ea3ull },
+    { 0xf057ad6e1b33554dull, 0x114a52dffc679925ull },
+    { 0x6c6d98c9a2002aa1ull, 0x159ce797fb817f6full },
+    { 0x4788fefc0a803549ull, 0x1b04217dfa61df4bull },
+    { 0x0cb59f5d8690214eull, 0x10e294eebc7d2b8full },
+    { 0xcfe30734e83429a1ull, 0x151b3a2a6b9c7672ull },
+    { 0x83dbc9022241340aull, 0x1a6208b50683940full },
+    { 0xb2695da15568c086ull, 0x107d457124123c89ull },
+    { 0x1f03b509aac2f0a7ull, 0x149c96cd6d16cbacull },
+    { 0x26c4a24c1573acd1ull, 0x19c3bc80c85c7e97ull },
+    { 0x783ae56f8d684c03ull, 0x101a55d07d39cf1eull },
+    { 0x16499ecb70c25f03ull, 0x1420eb449c8842e6ull },
+    { 0x9bdc067e4cf2f6c4ull, 0x19292615c3aa539full },
+    { 0x82d3081de02fb476ull, 0x1f736f9b3494e887ull },
+    { 0xb1c3e512ac1dd0c9ull, 0x13a825c100dd1154ull },
+    { 0xde34de57572544fcull, 0x18922f31411455a9ull },
+    { 0x55c215ed2cee963bull, 0x1eb6bafd91596b14ull },
+    { 0xb5994db43c151de5ull, 0x133234de7ad7e2ecull },
+    { 0xe2ffa1214b1a655eull, 0x17fec216198ddba7ull },
+    { 0xdbbf89699de0feb6ull, 0x1dfe729b9ff15291ull },
+    { 0x2957b5e202ac9f31ull, 0x12bf07a143f6d39bull },
+    { 0xf3ada35a8357c6feull, 0x176ec98994f48881ull },
+    { 0x70990c31242db8bdull, 0x1d4a7bebfa31aaa2ull },
+    { 0x865fa79eb69c9376ull, 0x124e8d737c5f0aa5ull },
+    { 0xe7f791866443b854ull, 0x16e230d05b76cd4eull },
+    { 0xa1f575e7fd54a669ull, 0x1c9abd04725480a2ull },
+    { 0xa53969b0fe54e801ull, 0x11e0b622c774d065ull },
+    { 0x0e87c41d3dea2202ull, 0x1658e3ab7952047full },
+    { 0xd229b5248d64aa82ull, 0x1bef1c9657a6859eull },
+    { 0x435a1136d85eea91ull, 0x117571ddf6c81383ull },
+    { 0x143095848e76a536ull, 0x15d2ce55747a1864ull },
+    { 0x193cbae5b2144e83ull, 0x1b4781ead1989e7dull },
+    { 0x2fc5f4cf8f4cb112ull, 0x110cb132c2ff630eull },
+    { 0xbbb77203731fdd56ull, 0x154fdd7f73bf3bd1ull },
+    { 0x2aa54e844fe7d4acull, 0x1aa3d4df50af0ac6ull },
+    { 0xdaa75112b1f0e4ebull, 0x10a6650b926d66bbull },
+    { 0xd15125575e6d1e26ull, 0x14cffe4e7708c06aull },
+    { 0x85a56ead360865b0ull, 0x1a03fde214caf085ull },
+    { 0x7387652c41c53f8eull, 0x10427ead4cfed653ull },
+    { 0x50693e7752368f71ull, 0x14531e58a03e8be8ull },
+    { 0x64838e1526c4334eull, 0x1967e5eec84e2ee2ull },
+    { 0xfda4719a70754022ull, 0x1fc1df6a7a61ba9aull },
+    { 0xde86c70086494815ull, 0x13d92ba28c7d14a0ull },
+    { 0x162878c0a7db9a1aull, 0x18cf768b2f9c59c9ull },
+    { 0x5bb296f0d1d280a1ull, 0x1f03542dfb83703bull },
+    { 0x194f9e5683239064ull, 0x1362149cbd322625ull },
+    { 0x5fa385ec23ec747eull, 0x183a99c3ec7eafaeull },
+    { 0xf78c67672ce7919dull, 0x1e494034e79e5b99ull },
+    { 0x3ab7c0a07c10bb02ull, 0x12edc82110c2f940ull },
+    { 0x4965b0c89b14e9c3ull, 0x17a93a2954f3b790ull },
+    { 0x5bbf1cfac1da2433ull, 0x1d9388b3aa30a574ull },
+    { 0xb957721cb92856a0ull, 0x127c35704a5e6768ull },
+    { 0xe7ad4ea3e7726c48ull, 0x171b42cc5cf60142ull },
+    { 0xa198a24ce14f075aull, 0x1ce2137f74338193ull },
+    { 0x44ff65700cd16498ull, 0x120d4c2fa8a030fcull },
+    { 0x563f3ecc1005bdbeull, 0x16909f3b92c83d3bull },
+    { 0x2bcf0e7f14072d2eull, 0x1c34c70a777a4c8aull },
+    { 0x5b61690f6c847c3dull, 0x11a0fc668aac6fd6ull },
+    { 0xf239c35347a59b4cull, 0x16093b802d578bcbull },
+    { 0xeec83428198f021full, 0x1b8b8a6038ad6ebeull },
+    { 0x553d20990ff96153ull, 0x1137367c236c6537ull },
+    { 0x2a8c68bf53f7b9a8ull, 0x1585041b2c477e85ull },
+    { 0x752f82ef28f5a812ull, 0x1ae64521f7595e26ull },
+    { 0x093db1d57999890bull, 0x10cfeb353a97dad8ull },
+    { 0x0b8d1e4ad7ffeb4eull, 0x1503e602893dd18eull },
+    { 0x8e7065dd8dffe622ull, 0x1a44df832b8d45f1ull },
+    { 0xf9063faa78bfefd5ull, 0x106b0bb1fb384bb6ull },
+    { 0xb747cf9516efebcaull, 0x1485ce9e7a065ea4ull },
+    { 0xe519c37a5cabe6bdull, 0x19a742461887f64dull },
+    { 0xaf301a2c79eb7036ull, 0x1008896bcf54f9f0ull },
+    { 0xdafc20b798664c43ull, 0x140aabc6c32a386cull },
+    { 0x11bb28e57e7fdf54ull, 0x190d56b873f4c688ull },
+    { 0x1629f31ede1fd72aull, 0x1f50ac6690f1f82aull },
+    { 0x4dda37f34ad3e67aull, 0x13926bc01a973b1aull },
+    { 0xe150c5f01d88e019ull, 0x187706b0213d09e0ull },
+    { 0x19a4f76c24eb181full, 0x1e94c85c298c4c59ull },
+    { 0xb0071aa39712ef13ull, 0x131cfd3999f7afb7ull },
+    { 0x9c08e14c7cd7aad8ull, 0x17e43c8800759ba5ull },
+    { 0x030b199f9c0d958eull, 0x1ddd4baa0093028full },
+    { 0x61e6f003c1887d79ull, 0x12aa4f4a405be199ull },
+    { 0xba60ac04b1ea9cd7ull, 0x1754e31cd072d9ffull },
+    { 0xa8f8d705de65440dull, 0x1d2a1be4048f907full },
+    { 0xc99b8663aaff4a88ull, 0x123a516e82d9ba4full },
+    { 0xbc0267fc95bf1d2aull, 0x16c8e5ca239028e3ull },
+    { 0xab0301fbbb2ee474ull, 0x1c7b1f3cac74331cull },
+    { 0xeae1e13d54fd4ec9ull, 0x11ccf385ebc89ff1ull },
+    { 0x659a598caa3ca27bull, 0x1640306766bac7eeull },
+    { 0xff00efefd4cbcb1aull, 0x1bd03c81406979e9ull },
+    { 0x3f6095f5e4ff5ef0ull, 0x116225d0c841ec32ull },
+    { 0xcf38bb735e3f36acull, 0x15baaf44fa52673eull },
+    { 0x8306ea5035cf0457ull, 0x1b295b1638e7010eull },
+    { 0x11e4527221a162b6ull, 0x10f9d8ede39060a9ull },
+    { 0x565d670eaa09bb64ull, 0x15384f295c7478d3ull },
+    { 0x2bf4c0d2548c2a3dull, 0x1a8662f3b3919708ull },
+    { 0x1b78f88374d79a66ull, 0x1093fdd8503afe65ull },
+    { 0x625736a4520d8100ull, 0x14b8fd4e6449bdfeull },
+    { 0xfaed044d6690e140ull, 0x19e73ca1fd5c2d7dull },
+    { 0xbcd422b0601a8cc8ull, 0x103085e53e599c6eull },
+    { 0x6c092b5c78212ffaull, 0x143ca75e8df0038aull },
+    { 0x070b763396297bf8ull, 0x194bd136316c046dull },
+    { 0x48ce53c07bb3daf6ull, 0x1f9ec583bdc70588ull },
+    { 0x2d80f4584d5068daull, 0x13c33b72569c6375ull },
+    { 0x78e1316e60a48310ull, 0x18b40a4eec437c52ull },
+};
+
+internal u32
+FormatPow5Bits(i32 e)
+{
+    return (u32)(((u32)e * 1217359) >> 19) + 1;
+}
+
+internal u32
+FormatLog10Pow2(i32 e)
+{
+    return ((u32)e * 78913) >> 18;
+}
+
+internal u32
+FormatLog10Pow5(i32 e)
+{
+    return ((u32)e * 732923) >> 20;
+}
+
+internal b32
+FormatMultipleOfPowerOf5(u64 value, u32 p)
+{
+    u32 count = 0;
+    while(value % 5 == 0)
+    {
+        value /= 5;
+        count += 1;
+    }
+    return count >= p;
+}
+
+internal b32
+FormatMultipleOfPowerOf2(u64 value, u32 p)
+{
+    return (value & (((u64)1 << p) - 1)) == 0;
+}
+
+internal u64
+FormatMulShift64(u64 m, u64 *multiplier, i32 shift)
+{
+#if _MSC_VER
+    u64 high0 = 0;
+    u64 high1 = 0;
+    _umul128(m, multiplier[0], &high0);
+    u64 low1 = _umul128(m, multiplier[1], &high1);
+    u64 sum = high0 + low1;
+    high1 += sum < high0;
+    return __shiftright128(sum, high1, (unsigned char)(shift - 64));
+#else
+    unsigned __int128 b0 = (unsigned __int128)m * multiplier[0];
+    unsigned __int128 b2 = (unsigned __int128)m * multiplier[1];
+    return (u64)(((b0 >> 64) + b2) >> (shift - 64));
+#endif
+}
+
+internal u32
+FormatMulShift32(u32 m, u64 factor, i32 shift)
+{
+    u64 bits0 = (u64)m * (u32)factor;
+    u64 bits1 = (u64)m * (factor >> 32);
+    return (u32)(((bits0 >> 32) + bits1) >> (shift - 32));
+}
+
+// NOTE(rjf): Ryu: the shortest decimal mantissa * 10^exponent that still
+// reads back as the same double, picking the closest one when there's a
+// choice. The interval of decimals that round to the value is scaled by a
+// power of five from the table, then digits are removed until the ends of
+// the interval meet.
+internal void
+FormatShortestF64(u64 ieee_mantissa, u32 ieee_exponent, u64 *mantissa_out, i32 *exponent_out)
+{
+    i32 e2 = 0;
+    u64 m2 = 0;
+    if(ieee_exponent == 0)
+    {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (i32)ieee_exponent - 1023 - 52 - 2;
+        m2 = ((u64)1 << 52) | ieee_mantissa;
+    }
+    b32 accept_bounds = (m2 & 1) == 0;
+    
+    u64 mv = 4*m2;
+    u32 mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+    
+    u64 vr, vp, vm;
+    i32 e10 = 0;
+    b32 vm_is_trailing_zeros = 0;
+    b32 vr_is_trailing_zeros = 0;
+    if(e2 >= 0)
+    {
+        u32 q = FormatLog10Pow2(e2) - (e2 > 3);
+        e10 = (i32)q;
+        i32 k = FORMAT_POW5_INV_BITCOUNT + FormatPow5Bits((i32)q) - 1;
+        i32 i = -e2 + (i32)q + k;
+        vr = FormatMulShift64(4*m2, global_format_pow5_inv_split[q], i);
+        vp = FormatMulShift64(4*m2 + 2, global_format_pow5_inv_split[q], i);
+        vm = FormatMulShift64(4*m2 - 1 - mm_shift, global_format_pow5_inv_split[q], i);
+        if(q <= 21)
+        {
+            if(mv % 5 == 0)
+            {
+                vr_is_trailing_zeros = FormatMultipleOfPowerOf5(mv, q);
+            }
+            else if(accept_bounds)
+            {
+                vm_is_trailing_zeros = FormatMultipleOfPowerOf5(mv - 1 - mm_shift, q);
+            }
+            else
+            {
+                vp -= FormatMultipleOfPowerOf5(mv + 2, q);
+            }
+        }
+    }
+    else
+    {
+        u32 q = FormatLog10Pow5(-e2) - (-e2 > 1);
+        e10 = (i32)q + e2;
+        i32 i = -e2 - (i32)q;
+        i32 k = FormatPow5Bits(i) - FORMAT_POW5_BITCOUNT;
+        i32 j = (i32)q - k;
+        vr = FormatMulShift64(4*m2, global_format_pow5_split[i], j);
+        vp = FormatMulShift64(4*m2 + 2, global_format_pow5_split[i], j);
+        vm = FormatMulShift64(4*m2 - 1 - mm_shift, global_format_pow5_split[i], j);
+        if(q <= 1)
+        {
+            vr_is_trailing_zeros = 1;
+            if(accept_bounds)
+            {
+                vm_is_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                --vp;
+            }
+        }
+        else if(q < 63)
+        {
+            vr_is_trailing_zeros = FormatMultipleOfPowerOf2(mv, q);
+        }
+    }
+    
+    i32 removed = 0;
+    u8 last_removed_digit = 0;
+    u64 output = 0;
+    if(vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        // NOTE(rjf): Rare general case, where exact ties and the interval's
+        // closed ends need tracking.
+        while(vp / 10 > vm / 10)
+        {
+            vm_is_trailing_zeros &= vm % 10 == 0;
+            vr_is_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        if(vm_is_trailing_zeros)
+        {
+            while(vm % 10 == 0)
+            {
+                vr_is_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (u8)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+        if(vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0)
+        {
+            last_removed_digit = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else
+    {
+        b32 round_up = 0;
+        if(vp / 100 > vm / 100)
+        {
+            round_up = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while(vp / 10 > vm / 10)
+        {
+            round_up = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        output = vr + (vr == vm || round_up);
+    }
+    
+    *mantissa_out = output;
+    *exponent_out = e10 + removed;
+}
+
+// NOTE(rjf): Same as above at single precision. The 32-bit multipliers are
+// the top halves of the double tables; the inverse table stores
+// floor(2^k / 5^q) + 1, and only the top half is used here, so the +1 goes
+// back on.
+internal void
+FormatShortestF32(u32 ieee_mantissa, u32 ieee_exponent, u64 *mantissa_out, i32 *exponent_out)
+{
+    i32 e2 = 0;
+    u32 m2 = 0;
+    if(ieee_exponent == 0)
+    {
+        e2 = 1 - 127 - 23 - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (i32)ieee_exponent - 127 - 23 - 2;
+        m2 = ((u32)1 << 23) | ieee_mantissa;
+    }
+    b32 accept_bounds = (m2 & 1) == 0;
+    
+    u32 mv = 4*m2;
+    u32 mp = 4*m2 + 2;
+    u32 mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+    u32 mm = 4*m2 - 1 - mm_shift;
+    
+    u32 vr, vp, vm;
+    i32 e10 = 0;
+    b32 vm_is_trailing_zeros = 0;
+    b32 vr_is_trailing_zeros = 0;
+    u8 last_removed_digit = 0;
+    i32 bitcount = FORMAT_POW5_INV_BITCOUNT - 64;
+    if(e2 >= 0)
+    {
+        u32 q = FormatLog10Pow2(e2);
+        e10 = (i32)q;
+        i32 k = bitcount + FormatPow5Bits((i32)q) - 1;
+        i32 i = -e2 + (i32)q + k;
+        u64 factor = global_format_pow5_inv_split[q][1] + 1;
+        vr = FormatMulShift32(mv, factor, i);
+        vp = FormatMulShift32(mp, factor, i);
+        vm = FormatMulShift32(mm, factor, i);
+        if(q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            i32 l = bitcount + FormatPow5Bits((i32)(q - 1)) - 1;
+            last_removed_digit = (u8)(FormatMulShift32(mv, global_format_pow5_inv_split[q - 1][1] + 1,
+                                                       -e2 + (i32)q - 1 + l) % 10);
+        }
+        if(q <= 9)
+        {
+            if(mv % 5 == 0)
+            {
+                vr_is_trailing_zeros = FormatMultipleOfPowerOf5(mv, q);
+            }
+            else if(accept_bounds)
+            {
+                vm_is_trailing_zeros = FormatMultipleOfPowerOf5(mm, q);
+            }
+            else
+            {
+                vp -= FormatMultipleOfPowerOf5(mp, q);
+            }
+        }
+    }
+    else
+    {
+        u32 q = FormatLog10Pow5(-e2);
+        e10 = (i32)q + e2;
+        i32 i = -e2 - (i32)q;
+        i32 k = FormatPow5Bits(i) - bitcount;
+        i32 j = (i32)q - k;
+        u64 factor = global_format_pow5_split[i][1];
+        vr = FormatMulShift32(mv, factor, j);
+        vp = FormatMulShift32(mp, factor, j);
+        vm = FormatMulShift32(mm, factor, j);
+        if(q != 0 && (vp - 1) / 10 <= vm / 10)
+        {
+            j = (i32)q - 1 - (FormatPow5Bits(i + 1) - bitcount);
+            last_removed_digit = (u8)(FormatMulShift32(mv, global_format_pow5_split[i + 1][1], j) % 10);
+        }
+        if(q <= 1)
+        {
+            vr_is_trailing_zeros = 1;
+            if(accept_bounds)
+            {
+                vm_is_trailing_zeros = mm_shift == 1;
+            }
+            else
+            {
+                --vp;
+            }
+        }
+        else if(q < 31)
+        {
+            vr_is_trailing_zeros = FormatMultipleOfPowerOf2(mv, q - 1);
+        }
+    }
+    
+    i32 removed = 0;
+    u32 output = 0;
+    if(vm_is_trailing_zeros || vr_is_trailing_zeros)
+    {
+        while(vp / 10 > vm / 10)
+        {
+            vm_is_trailing_zeros &= vm % 10 == 0;
+            vr_is_trailing_zeros &= last_removed_digit == 0;
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        if(vm_is_trailing_zeros)
+        {
+            while(vm % 10 == 0)
+            {
+                vr_is_trailing_zeros &= last_removed_digit == 0;
+                last_removed_digit = (u8)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                ++removed;
+            }
+        }
+        if(vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0)
+        {
+            last_removed_digit = 4;
+        }
+        output = vr + ((vr == vm && (!accept_bounds || !vm_is_trailing_zeros)) || last_removed_digit >= 5);
+    }
+    else
+    {
+        while(vp / 10 > vm / 10)
+        {
+            last_removed_digit = (u8)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+        }
+        output = vr + (vr == vm || last_removed_digit >= 5);
+    }
+    
+    *mantissa_out = output;
+    *exponent_out = e10 + removed;
+}
+
+// NOTE(rjf): Lays out digits * 10^exponent the way JavaScript prints
+// numbers: plain digits when the decimal point falls within 21 places of
+// them (123, 1.5, 0.000123), scientific otherwise (1.5e+21, 1e-7).
+internal u64
+FormatDecimal(u8 *buffer, b32 negative, u64 digits, i32 exponent)
+{
+    u8 *p = buffer;
+    if(negative)
+    {
+        *p++ = '-';
+    }
+    
+    u32 digit_count = FormatDigitCountU64(digits);
+    i32 point = (i32)digit_count + exponent;
+    if(point >= (i32)digit_count && point <= 21)
+    {
+        FormatDigitsU64(p, digits, digit_count);
+        p += digit_count;
+        for(i32 i = digit_count; i < point; ++i)
+        {
+            *p++ = '0';
+        }
+    }
+    else if(point > 0 && point <= 21)
+    {
+        FormatDigitsU64(p + 1, digits, digit_count);
+        MemoryMove(p, p + 1, point);
+        p[point] = '.';
+        p += digit_count + 1;
+    }
+    else if(point > -6 && point <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        for(i32 i = point; i < 0; ++i)
+        {
+            *p++ = '0';
+        }
+        FormatDigitsU64(p, digits, digit_count);
+        p += digit_count;
+    }
+    else
+    {
+        FormatDigitsU64(p + 1, digits, digit_count);
+        p[0] = p[1];
+        if(digit_count > 1)
+        {
+            p[1] = '.';
+            p += digit_count + 1;
+        }
+        else
+        {
+            p += 1;
+        }
+        i32 scientific_exponent = point - 1;
+        *p++ = 'e';
+        *p++ = scientific_exponent < 0 ? '-' : '+';
+        p += FormatU64(p, (u64)(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent));
+    }
+    return (u64)(p - buffer);
+}
+
+internal u64
+FormatSpecialFloat(u8 *buffer, b32 negative, b32 nan)
+{
+    u64 size = 0;
+    if(nan)
+    {
+        MemoryCopy(buffer, "nan", 3);
+        size = 3;
+    }
+    else
+    {
+        if(negative)
+        {
+            buffer[size++] = '-';
+        }
+        MemoryCopy(buffer + size, "inf", 3);
+        size += 3;
+    }
+    return size;
+}
+
+// NOTE(rjf): Shortest text that parses back to exactly the same value.
+internal u64
+FormatF64(u8 *buffer, f64 value)
+{
+    u64 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    b32 negative = (b32)(bits >> 63);
+    u32 ieee_exponent = (u32)((bits >> 52) & 0x7ff);
+    u64 ieee_mantissa = bits & (((u64)1 << 52) - 1);
+    
+    u64 size = 0;
+    if(ieee_exponent == 0x7ff)
+    {
+        size = FormatSpecialFloat(buffer, negative, ieee_mantissa != 0);
+    }
+    else if(ieee_exponent == 0 && ieee_mantissa == 0)
+    {
+        size = FormatDecimal(buffer, negative, 0, 0);
+    }
+    else
+    {
+        u64 digits = 0;
+        i32 exponent = 0;
+        FormatShortestF64(ieee_mantissa, ieee_exponent, &digits, &exponent);
+        size = FormatDecimal(buffer, negative, digits, exponent);
+    }
+    return size;
+}
+
+internal u64
+FormatF32(u8 *buffer, f32 value)
+{
+    u32 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    b32 negative = (b32)(bits >> 31);
+    u32 ieee_exponent = (bits >> 23) & 0xff;
+    u32 ieee_mantissa = bits & ((1u << 23) - 1);
+    
+    u64 size = 0;
+    if(ieee_exponent == 0xff)
+    {
+        size = FormatSpecialFloat(buffer, negative, ieee_mantissa != 0);
+    }
+    else if(ieee_exponent == 0 && ieee_mantissa == 0)
+    {
+        size = FormatDecimal(buffer, negative, 0, 0);
+    }
+    else
+    {
+        u64 digits = 0;
+        i32 exponent = 0;
+        FormatShortestF32(ieee_mantissa, ieee_exponent, &digits, &exponent);
+        size = FormatDecimal(buffer, negative, digits, exponent);
+    }
+    return size;
+}
+
+// NOTE(rjf): Pushes max_size bytes, lets the caller fill them, and gives
+// back the part it didn't use.
+internal u8 *
+FormatBeginPush(M_Arena *arena, u64 max_size)
+{
+    return M_ArenaPush(arena, max_size + 1);
+}
+
+internal String8
+FormatEndPush(M_Arena *arena, u8 *buffer, u64 max_size, u64 size)
+{
+    M_ArenaPop(arena, max_size - size);
+    buffer[size] = 0;
+    return S8(buffer, size);
+}
+
+internal String8
+PushStringU64(M_Arena *arena, u64 value)
+{
+    u8 *buffer = FormatBeginPush(arena, FORMAT_INTEGER_MAX);
+    return FormatEndPush(arena, buffer, FORMAT_INTEGER_MAX, FormatU64(buffer, value));
+}
+
+internal String8
+PushStringI64(M_Arena *arena, i64 value)
+{
+    u8 *buffer = FormatBeginPush(arena, FORMAT_INTEGER_MAX);
+    return FormatEndPush(arena, buffer, FORMAT_INTEGER_MAX, FormatI64(buffer, value));
+}
+
+internal String8
+PushStringHexU64(M_Arena *arena, u64 value, u32 min_digits)
+{
+    u8 *buffer = FormatBeginPush(arena, FORMAT_INTEGER_MAX);
+    return FormatEndPush(arena, buffer, FORMAT_INTEGER_MAX, FormatHexU64(buffer, value, min_digits));
+}
+
+internal String8
+PushStringF64(M_Arena *arena, f64 value)
+{
+    u8 *buffer = FormatBeginPush(arena, FORMAT_FLOAT_MAX);
+    return FormatEndPush(arena, buffer, FORMAT_FLOAT_MAX, FormatF64(buffer, value));
+}
+
+internal String8
+PushStringF32(M_Arena *arena, f32 value)
+{
+    u8 *buffer = FormatBeginPush(arena, FORMAT_FLOAT_MAX);
+    return FormatEndPush(arena, buffer, FORMAT_FLOAT_MAX, FormatF32(buffer, value));
+}
+
+// NOTE(rjf): Bulk versions: the whole array, joined by separator, as one
+// string.
+internal String8
+PushStringI64Array(M_Arena *arena, i64 *values, u64 count, String8 separator)
+{
+    u64 max_size = count*(FORMAT_INTEGER_MAX + separator.size);
+    u8 *buffer = FormatBeginPush(arena, max_size);
+    u64 size = 0;
+    for(u64 i = 0; i < count; ++i)
+    {
+        if(i > 0)
+        {
+            MemoryCopy(buffer + size, separator.str, separator.size);
+            size += separator.size;
+        }
+        size += FormatI64(buffer + size, values[i]);
+    }
+    return FormatEndPush(arena, buffer, max_size, size);
+}
+
+internal String8
+PushStringF64Array(M_Arena *arena, f64 *values, u64 count, String8 separator)
+{
+    u64 max_size = count*(FORMAT_FLOAT_MAX + separator.size);
+    u8 *buffer = FormatBeginPush(arena, max_size);
+    u64 size = 0;
+    for(u64 i = 0; i < count; ++i)
+    {
+        if(i > 0)
+        {
+            MemoryCopy(buffer + size, separator.str, separator.size);
+            size += separator.size;
+        }
+        size += FormatF64(buffer + size, values[i]);
+    }
+    return FormatEndPush(arena, buffer, max_size, size);
+}
+
+internal String8
+PushStringF32Array(M_Arena *arena, f32 *values, u64 count, String8 separator)
+{
+    u64 max_size = count*(FORMAT_FLOAT_MAX + separator.size);
+    u8 *buffer = FormatBeginPush(arena, max_size);
+    u64 size = 0;
+    for(u64 i = 0; i < count; ++i)
+    {
+        if(i > 0)
+        {
+            MemoryCopy(buffer + size, separator.str, separator.size);
+            size += separator.size;
+        }
+        size += FormatF32(buffer + size, values[i]);
+    }
+    return FormatEndPush(arena, buffer, max_size, size);
+}
+
+//~ NOTE(rjf): String Formatting
+
+// NOTE(rjf): printf-style formatting straight into an arena, in one pass.
+// On top of the usual conversions, %S takes a String8 (precision limits it
+// like %s). Floats go through the shortest-digits formatter above whenever
+// that gives the same answer as printf would; long doubles, %a, subnormals,
+// more than 15 significant digits and exact decimal ties fall back to
+// snprintf for that one conversion. %p prints 0x followed by lowercase hex.
+// Unknown conversions are copied through as they are.
+
+#define FORMAT_FAST_DIGITS_MAX 15
+#define FORMAT_FAST_PRECISION_MAX 64
+
+internal FormatWriter
+FormatWriterBegin(M_Arena *arena)
+{
+    FormatWriter writer = {0};
+    writer.arena = arena;
+    writer.str = (u8 *)arena->base + arena->alloc_position;
+    if(arena->commit_position > arena->alloc_position)
+    {
+        writer.capacity = arena->commit_position - arena->alloc_position - 1;
+    }
+    return writer;
+}
+
+// NOTE(rjf): Commits more of the arena without pushing, so the arena's own
+// commit policy decides how much and nothing is charged to this callsite.
+internal void
+FormatWriterReserve(FormatWriter *writer, u64 size)
+{
+    if(writer->size + size > writer->capacity)
+    {
+        M_Arena *arena = writer->arena;
+        M_ArenaEnsureCommitted(arena, arena->alloc_position + writer->size + size + 1);
+        writer->capacity = arena->commit_position - arena->alloc_position - 1;
+    }
+}
+
+internal void
+FormatWriterPush(FormatWriter *writer, void *data, u64 size)
+{
+    FormatWriterReserve(writer, size);
+    MemoryCopy(writer->str + writer->size, data, size);
+    writer->size += size;
+}
+
+internal void
+FormatWriterFill(FormatWriter *writer, u8 c, u64 count)
+{
+    FormatWriterReserve(writer, count);
+    MemorySet(writer->str + writer->size, c, count);
+    writer->size += count;
+}
+
+internal String8
+FormatWriterEnd(FormatWriter *writer)
+{
+    String8 result = S8(M_ArenaPush(writer->arena, writer->size + 1), writer->size);
     result.str[result.size] = 0;
+    return result;
+}
+
+// NOTE(rjf): Writes prefix (sign, 0x), then leading_zeros zeros, then body,
+// padded out to the spec's width.
+internal void
+FormatWriterPushField(FormatWriter *writer, FormatSpec *spec, String8 prefix, u64 leading_zeros, String8 body)
+{
+    u64 total = prefix.size + leading_zeros + body.size;
+    u64 padding = spec->width > 0 && (u64)spec->width > total ? (u64)spec->width - total : 0;
+    if(padding && !(spec->flags & FormatFlag_LeftJustify))
+    {
+        if(spec->flags & FormatFlag_ZeroPad)
+        {
+            leading_zeros += padding;
+        }
+        else
+        {
+            FormatWriterFill(writer, ' ', padding);
+        }
+        padding = 0;
+    }
+    FormatWriterPush(writer, prefix.str, prefix.size);
+    FormatWriterFill(writer, '0', leading_zeros);
+    FormatWriterPush(writer, body.str, body.size);
+    FormatWriterFill(writer, ' ', padding);
+}
+
+internal String8
+FormatSignPrefix(u8 *buffer, FormatSpec *spec, b32 negative)
+{
+    u64 size = 0;
+    if(negative)
+    {
+        buffer[size++] = '-';
+    }
+    else if(spec->flags & FormatFlag_Plus)
+    {
+        buffer[size++] = '+';
+    }
+    else if(spec->flags & FormatFlag_Space)
+    {
+        buffer[size++] = ' ';
+    }
+    return S8(buffer, size);
+}
+
+// NOTE(rjf): Returns the format past the spec. Leaves conversion at 0 if
+// the format ends mid-spec.
+internal char *
+FormatParseSpec(char *format, va_list *args, FormatSpec *spec)
+{
+    MemorySet(spec, 0, sizeof(*spec));
+    spec->precision = -1;
+    
+    for(b32 parsing_flags = 1; parsing_flags; )
+    {
+        switch(*format)
+        {
+            case '-': { spec->flags |= FormatFlag_LeftJustify; ++format; }break;
+            case '0': { spec->flags |= FormatFlag_ZeroPad; ++format; }break;
+            case '+': { spec->flags |= FormatFlag_Plus; ++format; }break;
+            case ' ': { spec->flags |= FormatFlag_Space; ++format; }break;
+            case '#': { spec->flags |= FormatFlag_Alternate; ++format; }break;
+            default: { parsing_flags = 0; }break;
+        }
+    }
+    
+    if(*format == '*')
+    {
+        spec->width = va_arg(*args, int);
+        if(spec->width < 0)
+        {
+            spec->flags |= FormatFlag_LeftJustify;
+            spec->width = -spec->width;
+        }
+        ++format;
+    }
+    else
+    {
+        while(CharIsDigit(*format))
+        {
+            spec->width = spec->width*10 + (*format++ - '0');
+        }
+    }
+    
+    if(*format == '.')
+    {
+        ++format;
+        spec->precision = 0;
+        if(*format == '*')
+        {
+            spec->precision = va_arg(*args, int);
+            if(spec->precision < 0)
+            {
+                spec->precision = -1;
+            }
+            ++format;
+        }
+        else
+        {
+            while(CharIsDigit(*format))
+            {
+                spec->precision = spec->precision*10 + (*format++ - '0');
+            }
+        }
+    }
+    
+    if(*format == 'h' || *format == 'l')
+    {
+        spec->length[0] = *format++;
+        if(*format == spec->length[0])
+        {
+            spec->length[1] = *format++;
+        }
+    }
+    else if(*format == 'z' || *format == 'j' || *format == 't' || *format == 'L')
+    {
+        spec->length[0] = *format++;
+    }
+    
+    if(*format)
+    {
+        spec->conversion = *format++;
+        if(spec->flags & FormatFlag_LeftJustify)
+        {
+            spec->flags &= ~FormatFlag_ZeroPad;
+        }
+    }
+    return format;
+}
+
+internal u64
+FormatReadUnsigned(va_list *args, FormatSpec *spec)
+{
+    u64 value = 0;
+    switch(spec->length[0])
+    {
+        case 'h': { value = spec->length[1] ? (u8)va_arg(*args, unsigned int) : (u16)va_arg(*args, unsigned int); }break;
+        case 'l': { value = spec->length[1] ? (u64)va_arg(*args, unsigned long long) : (u64)va_arg(*args, unsigned long); }break;
+        case 'z': { value = (u64)va_arg(*args, size_t); }break;
+        case 'j': { value = (u64)va_arg(*args, uintmax_t); }break;
+        case 't': { value = (u64)va_arg(*args, uintptr_t); }break;
+        default:  { value = va_arg(*args, unsigned int); }break;
+    }
+    return value;
+}
+
+internal i64
+FormatReadSigned(va_list *args, FormatSpec *spec)
+{
+    i64 value = 0;
+    switch(spec->length[0])
+    {
+        case 'h': { value = spec->length[1] ? (i8)va_arg(*args, int) : (i16)va_arg(*args, int); }break;
+        case 'l': { value = spec->length[1] ? (i64)va_arg(*args, long long) : (i64)va_arg(*args, long); }break;
+        case 'z': { value = (i64)va_arg(*args, size_t); }break;
+        case 'j': { value = (i64)va_arg(*args, intmax_t); }break;
+        case 't': { value = (i64)va_arg(*args, intptr_t); }break;
+        default:  { value = va_arg(*args, int); }break;
+    }
+    return value;
+}
+
+internal void
+FormatWriterPushInteger(FormatWriter *writer, FormatSpec *spec, u64 magnitude, b32 negative)
+{
+    u8 prefix_buffer[4];
+    u8 body_buffer[24];
+    String8 prefix = S8(prefix_buffer, 0);
+    String8 body = S8(body_buffer, 0);
+    u8 conversion = spec->conversion;
+    
+    if(conversion == 'd' || conversion == 'i')
+    {
+        prefix = FormatSignPrefix(prefix_buffer, spec, negative);
+    }
+    
+    // NOTE(rjf): An explicit zero precision prints nothing for zero.
+    if(magnitude != 0 || spec->precision != 0)
+    {
+        if(conversion == 'x' || conversion == 'X')
+        {
+            body.size = FormatHexU64(body.str, magnitude, 1);
+            if(conversion == 'X')
+            {
+                ConvertStringToUppercase(body);
+            }
+            if((spec->flags & FormatFlag_Alternate) && magnitude != 0)
+            {
+                prefix_buffer[0] = '0';
+                prefix_buffer[1] = conversion;
+                prefix.size = 2;
+            }
+        }
+        else if(conversion == 'o')
+        {
+            u8 *end = body_buffer + sizeof(body_buffer);
+            u8 *start = end;
+            do
+            {
+                *--start = (u8)('0' + (magnitude & 7));
+                magnitude >>= 3;
+            } while(magnitude);
+            body = S8(start, (u64)(end - start));
+        }
+        else
+        {
+            body.size = FormatU64(body.str, magnitude);
+        }
+    }
+    
+    u64 leading_zeros = 0;
+    if(spec->precision >= 0)
+    {
+        leading_zeros = (u64)spec->precision > body.size ? (u64)spec->precision - body.size : 0;
+        spec->flags &= ~FormatFlag_ZeroPad;
+    }
+    if(conversion == 'o' && (spec->flags & FormatFlag_Alternate) && leading_zeros == 0 &&
+       (body.size == 0 || body.str[0] != '0'))
+    {
+        leading_zeros = 1;
+    }
+    
+    FormatWriterPushField(writer, spec, prefix, leading_zeros, body);
+}
+
+internal void
+FormatWriterPushText(FormatWriter *writer, FormatSpec *spec, String8 text)
+{
+    if(spec->precision >= 0 && (u64)spec->precision < text.size)
+    {
+        text.size = (u64)spec->precision;
+    }
+    spec->flags &= ~FormatFlag_ZeroPad;
+    FormatWriterPushField(writer, spec, S8(0, 0), 0, text);
+}
+
+// NOTE(rjf): Rounds digits * 10^exponent to a multiple of 10^round_exponent,
+// half to even like printf. Returns 0 when the digits sit exactly on the
+// halfway point: the shortest digits can't tell which side of it the real
+// binary value is on.
+internal b32
+FormatRoundDecimal(u64 digits, i32 exponent, i32 round_exponent, u64 *rounded_out)
+{
+    b32 result = 1;
+    i32 drop = round_exponent - exponent;
+    u64 rounded = 0;
+    if(drop <= 0)
+    {
+        rounded = digits * global_format_powers_of_ten[-drop];
+    }
+    else if(drop < (i32)ArrayCount(global_format_powers_of_ten))
+    {
+        u64 divisor = global_format_powers_of_ten[drop];
+        u64 remainder = digits % divisor;
+        rounded = digits / divisor;
+        if(remainder > divisor / 2)
+        {
+            rounded += 1;
+        }
+        else if(remainder == divisor / 2 && remainder != 0)
+        {
+            result = 0;
+        }
+    }
+    *rounded_out = rounded;
+    return result;
+}
+
+// NOTE(rjf): %f, %e and %g from the shortest round-trip digits. Those are
+// within half an ulp of the value, so rounding them to at most
+// FORMAT_FAST_DIGITS_MAX significant digits gives the same result as
+// rounding the exact binary value, barring the ties FormatRoundDecimal
+// rejects. Returns 0 when the caller has to fall back to snprintf.
+internal b32
+FormatWriterPushFloatFast(FormatWriter *writer, FormatSpec *spec, f64 value)
+{
+    u64 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    b32 negative = (b32)(bits >> 63);
+    u32 ieee_exponent = (u32)((bits >> 52) & 0x7ff);
+    u64 ieee_mantissa = bits & (((u64)1 << 52) - 1);
+    u8 conversion = CharToLower(spec->conversion);
+    b32 uppercase = spec->conversion != conversion;
+    b32 alternate = !!(spec->flags & FormatFlag_Alternate);
+    i32 precision = spec->precision < 0 ? 6 : spec->precision;
+    
+    u8 prefix_buffer[4];
+    u8 body_buffer[FORMAT_FAST_PRECISION_MAX + 32];
+    String8 prefix = FormatSignPrefix(prefix_buffer, spec, negative);
+    String8 body = S8(body_buffer, 0);
+    
+    if(ieee_exponent == 0x7ff)
+    {
+        MemoryCopy(body.str, ieee_mantissa ? (uppercase ? "NAN" : "nan") : (uppercase ? "INF" : "inf"), 3);
+        body.size = 3;
+        spec->flags &= ~FormatFlag_ZeroPad;
+        FormatWriterPushField(writer, spec, prefix, 0, body);
+        return 1;
+    }
+    if((ieee_exponent == 0 && ieee_mantissa != 0) || precision > FORMAT_FAST_PRECISION_MAX)
+    {
+        return 0;
+    }
+    
+    u64 digits = 0;
+    i32 exponent = 0;
+    if(ieee_exponent != 0)
+    {
+        FormatShortestF64(ieee_mantissa, ieee_exponent, &digits, &exponent);
+    }
+    i32 digit_count = (i32)FormatDigitCountU64(digits);
+    
+    // NOTE(rjf): %g picks %e or %f by the exponent %e would print, and
+    // counts precision in significant digits.
+    b32 strip_zeros = 0;
+    if(conversion == 'g')
+    {
+        precision = Max(precision, 1);
+        i32 scientific_exponent = 0;
+        if(digits != 0)
+        {
+            u64 rounded = 0;
+            if(precision > FORMAT_FAST_DIGITS_MAX ||
+               !FormatRoundDecimal(digits, exponent, exponent + digit_count - precision, &rounded))
+            {
+                return 0;
+            }
+            scientific_exponent = exponent + digit_count - 1 + (rounded == global_format_powers_of_ten[precision]);
+        }
+        if(scientific_exponent >= -4 && scientific_exponent < precision)
+        {
+            conversion = 'f';
+            precision = precision - 1 - scientific_exponent;
+        }
+        else
+        {
+            conversion = 'e';
+            precision = precision - 1;
+        }
+        strip_zeros = !alternate;
+    }
+    
+    u8 *p = body.str;
+    if(conversion == 'f')
+    {
+        if(digits != 0 && exponent + digit_count + precision > FORMAT_FAST_DIGITS_MAX)
+        {
+            return 0;
+        }
+        u64 rounded = 0;
+        if(!FormatRoundDecimal(digits, exponent, -precision, &rounded))
+        {
+            return 0;
+        }
+        
+        // NOTE(rjf): rounded is the value times 10^precision; pad it so
+        // there is at least one digit before the point.
+        u32 rounded_count = FormatDigitCountU64(rounded);
+        u32 padded_count = Max(rounded_count, (u32)precision + 1);
+        MemorySet(p, '0', padded_count - rounded_count);
+        FormatDigitsU64(p + padded_count - rounded_count, rounded, rounded_count);
+        u32 integer_count = padded_count - (u32)precision;
+        if(precision > 0 || alternate)
+        {
+            MemoryMove(p + integer_count + 1, p + integer_count, precision);
+            p[integer_count] = '.';
+            p += padded_count + 1;
+        }
+        else
+        {
+            p += padded_count;
+        }
+    }
+    else
+    {
+        if(precision + 1 > FORMAT_FAST_DIGITS_MAX)
+        {
+            return 0;
+        }
+        u64 rounded = 0;
+        i32 scientific_exponent = 0;
+        if(digits != 0)
+        {
+            if(!FormatRoundDecimal(digits, exponent, exponent + digit_count - (precision + 1), &rounded))
+            {
+                return 0;
+            }
+            scientific_exponent = exponent + digit_count - 1;
+            if(rounded == global_format_powers_of_ten[precision + 1])
+            {
+                rounded /= 10;
+                scientific_exponent += 1;
+            }
+        }
+        MemorySet(p + 1, '0', precision + 1);
+        FormatDigitsU64(p + 1, rounded, (u32)precision + 1);
+        p[0] = p[1];
+        if(precision > 0 || alternate)
+        {
+            p[1] = '.';
+            p += precision + 2;
+        }
+        else
+        {
+            p += 1;
+        }
+        
+        // NOTE(rjf): Trailing zeros come off the mantissa, before the
+        // exponent goes on.
+        if(strip_zeros && precision > 0)
+        {
+            while(p[-1] == '0')
+            {
+                --p;
+            }
+            if(p[-1] == '.')
+            {
+                --p;
+            }
+            strip_zeros = 0;
+        }
+        
+        *p++ = uppercase ? 'E' : 'e';
+        *p++ = scientific_exponent < 0 ? '-' : '+';
+        u32 exponent_magnitude = (u32)(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent);
+        if(exponent_magnitude < 10)
+        {
+            *p++ = '0';
+        }
+        p += FormatU64(p, exponent_magnitude);
+    }
+    
+    if(strip_zeros && precision > 0)
+    {
+        while(p[-1] == '0')
+        {
+            --p;
+        }
+        if(p[-1] == '.')
+        {
+            --p;
+        }
+    }
+    
+    body.size = (u64)(p - body.str);
+    FormatWriterPushField(writer, spec, prefix, 0, body);
+    return 1;
+}
+
+// NOTE(rjf): Hands one conversion to snprintf, rebuilding the spec text.
+internal void
+FormatWriterPushFloatSlow(FormatWriter *writer, FormatSpec *spec, f64 value, long double long_value)
+{
+    char format[32];
+    char *f = format;
+    *f++ = '%';
+    if(spec->flags & FormatFlag_LeftJustify) { *f++ = '-'; }
+    if(spec->flags & FormatFlag_ZeroPad)     { *f++ = '0'; }
+    if(spec->flags & FormatFlag_Plus)        { *f++ = '+'; }
+    if(spec->flags & FormatFlag_Space)       { *f++ = ' '; }
+    if(spec->flags & FormatFlag_Alternate)   { *f++ = '#'; }
+    *f++ = '*';
+    *f++ = '.';
+    *f++ = '*';
+    if(spec->length[0] == 'L')
+    {
+        *f++ = 'L';
+    }
+    *f++ = spec->conversion;
+    *f = 0;
+    
+    for(u64 reserve = 64;;)
+    {
+        FormatWriterReserve(writer, reserve);
+        char *destination = (char *)writer->str + writer->size;
+        u64 available = writer->capacity - writer->size + 1;
+        int written = (spec->length[0] == 'L' ?
+                       snprintf(destination, available, format, spec->width, spec->precision, long_value) :
+                       snprintf(destination, available, format, spec->width, spec->precision, value));
+        if(written < 0)
+        {
+            break;
+        }
+        if((u64)written < available)
+        {
+            writer->size += (u64)written;
+            break;
+        }
+        reserve = (u64)written;
+    }
+}
+
+internal String8
+PushStringFV(M_Arena *arena, char *format, va_list args)
+{
+    va_list arg_list;
+    va_copy(arg_list, args);
+    FormatWriter writer = FormatWriterBegin(arena);
+    
+    for(char *at = format; *at;)
+    {
+        // NOTE(rjf): Copy literal text up to the next conversion in one go.
+        char *literal_end = at;
+        while(*literal_end && *literal_end != '%')
+        {
+            ++literal_end;
+        }
+        if(literal_end > at)
+        {
+            FormatWriterPush(&writer, at, (u64)(literal_end - at));
+            at = literal_end;
+            continue;
+        }
+        
+        char *spec_start = at;
+        FormatSpec spec = {0};
+        at = FormatParseSpec(at + 1, &arg_list, &spec);
+        switch(spec.conversion)
+        {
+            case 'd':
+            case 'i':
+            {
+                i64 value = FormatReadSigned(&arg_list, &spec);
+                FormatWriterPushInteger(&writer, &spec, value < 0 ? 0 - (u64)value : (u64)value, value < 0);
+            }break;
+            
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            {
+                FormatWriterPushInteger(&writer, &spec, FormatReadUnsigned(&arg_list, &spec), 0);
+            }break;
+            
+            case 'c':
+            {
+                u8 c = (u8)va_arg(arg_list, int);
+                spec.precision = -1;
+                FormatWriterPushText(&writer, &spec, S8(&c, 1));
+            }break;
+            
+            case 's':
+            {
+                char *string = va_arg(arg_list, char *);
+                if(string == 0)
+                {
+                    string = "(null)";
+                }
+                u64 size = 0;
+                if(spec.precision >= 0)
+                {
+                    char *end = memchr(string, 0, (u64)spec.precision);
+                    size = end ? (u64)(end - string) : (u64)spec.precision;
+                }
+                else
+                {
+                    size = strlen(string);
+                }
+                FormatWriterPushText(&writer, &spec, S8((u8 *)string, size));
+            }break;
+            
+            case 'S':
+            {
+                FormatWriterPushText(&writer, &spec, va_arg(arg_list, String8));
+            }break;
+            
+            case 'p':
+            {
+                u8 buffer[2 + FORMAT_INTEGER_MAX] = "0x";
+                u64 size = 2 + FormatHexU64(buffer + 2, (u64)(uintptr_t)va_arg(arg_list, void *), 1);
+                spec.precision = -1;
+                FormatWriterPushText(&writer, &spec, S8(buffer, size));
+            }break;
+            
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+            {
+                if(spec.length[0] == 'L')
+                {
+                    FormatWriterPushFloatSlow(&writer, &spec, 0, va_arg(arg_list, long double));
+                }
+                else
+                {
+                    f64 value = va_arg(arg_list, f64);
+                    if(spec.conversion == 'a' || spec.conversion == 'A' ||
+                       !FormatWriterPushFloatFast(&writer, &spec, value))
+                    {
+                        FormatWriterPushFloatSlow(&writer, &spec, value, 0);
+                    }
+                }
+            }break;
+            
+            case '%':
+            {
+                FormatWriterPush(&writer, "%", 1);
+            }break;
+            
+            default:
+            {
+                FormatWriterPush(&writer, spec_start, (u64)(at - spec_start));
+            }break;
+        }
+    }
+    
+    va_end(arg_list);
+    return FormatWriterEnd(&writer);
+}
+
+internal String8
+PushStringF(M_Arena *arena, char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    String8 result = PushStringFV(arena, fmt, args);
+    va_end(args);
     return(result);
 }
 
-internal String8
-PushStringF(M_Arena *arena, char *fmt, ...)
+//~ NOTE(rjf): String Lists
+
+internal void
+String8ListPushNode(String8List *list, String8Node *node)
+{
+    node->next = 0;
+    if(list->last)
+    {
+        list->last->next = node;
+    }
+    else
+    {
+        list->first = node;
+    }
+    list->last = node;
+    list->node_count += 1;
+    list->total_size += node->string.size;
+}
+
+// NOTE(rjf): Only the node is allocated; the list refers to string's memory.
+internal String8Node *
+String8ListPush(M_Arena *arena, String8List *list, String8 string)
+{
+    String8Node *node = M_PushStruct(arena, String8Node);
+    node->string = string;
+    String8ListPushNode(list, node);
+    return node;
+}
+
+internal String8Node *
+String8ListPushFV(M_Arena *arena, String8List *list, char *format, va_list args)
+{
+    String8Node *node = M_PushStruct(arena, String8Node);
+    node->string = PushStringFV(arena, format, args);
+    String8ListPushNode(list, node);
+    return node;
+}
+
+internal String8Node *
+String8ListPushF(M_Arena *arena, String8List *list, char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    String8Node *node = String8ListPushFV(arena, list, format, args);
+    va_end(args);
+    return node;
+}
+
+// NOTE(rjf): Moves every node of to_push onto the end of list, leaving
+// to_push empty.
+internal void
+String8ListConcat(String8List *list, String8List *to_push)
+{
+    if(to_push->first)
+    {
+        if(list->last)
+        {
+            list->last->next = to_push->first;
+        }
+        else
+        {
+            list->first = to_push->first;
+        }
+        list->last = to_push->last;
+        list->node_count += to_push->node_count;
+        list->total_size += to_push->total_size;
+        MemorySet(to_push, 0, sizeof(*to_push));
+    }
+}
+
+// NOTE(rjf): One push of the exact size, then one copy per node.
+internal String8
+String8ListJoin(M_Arena *arena, String8List *list, String8 separator)
+{
+    u64 size = list->total_size;
+    if(list->node_count > 1)
+    {
+        size += separator.size*(list->node_count - 1);
+    }
+    String8 result = S8(M_ArenaPush(arena, size + 1), size);
+    u8 *at = result.str;
+    for(String8Node *node = list->first; node; node = node->next)
+    {
+        if(node != list->first)
+        {
+            MemoryCopy(at, separator.str, separator.size);
+            at += separator.size;
+        }
+        MemoryCopy(at, node->string.str, node->string.size);
+        at += node->string.size;
+    }
+    result.str[result.size] = 0;
+    return result;
+}
+
+//~ NOTE(rjf): Unicode
+
+// NOTE(rjf): Decoding is strict: overlong forms, surrogates, code points
+// past U+10FFFF and truncated sequences all decode as one U+FFFD per
+// offending byte (per unpaired surrogate in UTF-16), so every conversion
+// below produces valid output from any input. Sizes are in code units
+// (bytes for String8, u16s for String16, u32s for String32), and arena
+// results are NUL-terminated.
+
+#define UNICODE_REPLACEMENT_CHARACTER 0xfffd
+#define UNICODE_MAX_CODEPOINT         0x10ffff
+
+internal UnicodeDecode
+UTF8DecodeCodepoint(u8 *str, u64 max)
+{
+    UnicodeDecode result = { UNICODE_REPLACEMENT_CHARACTER, 1 };
+    u8 byte = str[0];
+    if(byte < 0x80)
+    {
+        result.codepoint = byte;
+    }
+    else if(byte >= 0xc2 && byte <= 0xdf)
+    {
+        if(max >= 2 && (str[1] & 0xc0) == 0x80)
+        {
+            result.codepoint = ((u32)(byte & 0x1f) << 6) | (str[1] & 0x3f);
+            result.advance = 2;
+        }
+    }
+    else if(byte >= 0xe0 && byte <= 0xef)
+    {
+        // NOTE(rjf): The second byte's range rules out overlong forms (E0)
+        // and surrogates (ED).
+        u8 low = byte == 0xe0 ? 0xa0 : 0x80;
+        u8 high = byte == 0xed ? 0x9f : 0xbf;
+        if(max >= 3 && str[1] >= low && str[1] <= high && (str[2] & 0xc0) == 0x80)
+        {
+            result.codepoint = (((u32)(byte & 0x0f) << 12) | ((u32)(str[1] & 0x3f) << 6) |
+                                (str[2] & 0x3f));
+            result.advance = 3;
+        }
+    }
+    else if(byte >= 0xf0 && byte <= 0xf4)
+    {
+        // NOTE(rjf): Likewise overlong forms (F0) and past U+10FFFF (F4).
+        u8 low = byte == 0xf0 ? 0x90 : 0x80;
+        u8 high = byte == 0xf4 ? 0x8f : 0xbf;
+        if(max >= 4 && str[1] >= low && str[1] <= high &&
+           (str[2] & 0xc0) == 0x80 && (str[3] & 0xc0) == 0x80)
+        {
+            result.codepoint = (((u32)(byte & 0x07) << 18) | ((u32)(str[1] & 0x3f) << 12) |
+                                ((u32)(str[2] & 0x3f) << 6) | (str[3] & 0x3f));
+            result.advance = 4;
+        }
+    }
+    return result;
+}
+
+internal u32
+UTF8EncodeCodepoint(u8 *out, u32 codepoint)
+{
+    u32 size = 0;
+    if(codepoint > UNICODE_MAX_CODEPOINT || (codepoint >= 0xd800 && codepoint <= 0xdfff))
+    {
+        codepoint = UNICODE_REPLACEMENT_CHARACTER;
+    }
+    if(codepoint < 0x80)
+    {
+        out[0] = (u8)codepoint;
+        size = 1;
+    }
+    else if(codepoint < 0x800)
+    {
+        out[0] = (u8)(0xc0 | (codepoint >> 6));
+        out[1] = (u8)(0x80 | (codepoint & 0x3f));
+        size = 2;
+    }
+    else if(codepoint < 0x10000)
+    {
+        out[0] = (u8)(0xe0 | (codepoint >> 12));
+        out[1] = (u8)(0x80 | ((codepoint >> 6) & 0x3f));
+        out[2] = (u8)(0x80 | (codepoint & 0x3f));
+        size = 3;
+    }
+    else
+    {
+        out[0] = (u8)(0xf0 | (codepoint >> 18));
+        out[1] = (u8)(0x80 | ((codepoint >> 12) & 0x3f));
+        out[2] = (u8)(0x80 | ((codepoint >> 6) & 0x3f));
+        out[3] = (u8)(0x80 | (codepoint & 0x3f));
+        size = 4;
+    }
+    return size;
+}
+
+internal UnicodeDecode
+UTF16DecodeCodepoint(u16 *str, u64 max)
+{
+    UnicodeDecode result = { str[0], 1 };
+    if(str[0] >= 0xd800 && str[0] <= 0xdfff)
+    {
+        result.codepoint = UNICODE_REPLACEMENT_CHARACTER;
+        if(str[0] <= 0xdbff && max >= 2 && str[1] >= 0xdc00 && str[1] <= 0xdfff)
+        {
+            result.codepoint = 0x10000 + (((u32)(str[0] - 0xd800) << 10) | (u32)(str[1] - 0xdc00));
+            result.advance = 2;
+        }
+    }
+    return result;
+}
+
+internal u32
+UTF16EncodeCodepoint(u16 *out, u32 codepoint)
+{
+    u32 size = 1;
+    if(codepoint > UNICODE_MAX_CODEPOINT || (codepoint >= 0xd800 && codepoint <= 0xdfff))
+    {
+        codepoint = UNICODE_REPLACEMENT_CHARACTER;
+    }
+    if(codepoint < 0x10000)
+    {
+        out[0] = (u16)codepoint;
+    }
+    else
+    {
+        codepoint -= 0x10000;
+        out[0] = (u16)(0xd800 | (codepoint >> 10));
+        out[1] = (u16)(0xdc00 | (codepoint & 0x3ff));
+        size = 2;
+    }
+    return size;
+}
+
+// NOTE(rjf): Returns the offset of the first byte that isn't part of valid
+// UTF-8, or string.size if it all is. ASCII is skipped 32 bytes at a time.
+internal u64
+UTF8Validate(String8 string)
+{
+    u64 i = 0;
+    while(i < string.size)
+    {
+        if(i + 32 <= string.size)
+        {
+            __m128i a = _mm_loadu_si128((__m128i *)(string.str + i));
+            __m128i b = _mm_loadu_si128((__m128i *)(string.str + i + 16));
+            if(_mm_movemask_epi8(_mm_or_si128(a, b)) == 0)
+            {
+                i += 32;
+                continue;
+            }
+        }
+        
+        // NOTE(rjf): Go through the block byte by byte before trying the
+        // fast path again, so mixed text doesn't pay for failed checks.
+        u64 block_end = Min(i + 32, string.size);
+        b32 valid = 1;
+        while(valid && i < block_end)
+        {
+            if(string.str[i] < 0x80)
+            {
+                i += 1;
+            }
+            else
+            {
+                UnicodeDecode decode = UTF8DecodeCodepoint(string.str + i, string.size - i);
+                valid = decode.advance > 1;
+                i += valid ? decode.advance : 0;
+            }
+        }
+        if(!valid)
+        {
+            break;
+        }
+    }
+    return Min(i, string.size);
+}
+
+// NOTE(rjf): Counts lead bytes, i.e. everything but 10xxxxxx, 16 at a time.
+// For valid UTF-8 that's the number of code points.
+internal u64
+UTF8CodepointCount(String8 string)
+{
+    u64 count = 0;
+    u64 i = 0;
+    __m128i continuation_limit = _mm_set1_epi8((char)0xbf);
+    while(i + 16 <= string.size)
+    {
+        // NOTE(rjf): Byte counters go up by one per block, so they're
+        // flushed into the total before they can wrap.
+        __m128i counters = _mm_setzero_si128();
+        u64 end = Min(string.size - 15, i + 255*16);
+        for(; i < end; i += 16)
+        {
+            __m128i x = _mm_loadu_si128((__m128i *)(string.str + i));
+            __m128i lead = _mm_cmpgt_epi8(x, continuation_limit);
+            counters = _mm_sub_epi8(counters, lead);
+        }
+        __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        count += (u64)_mm_cvtsi128_si32(sums) + (u64)_mm_extract_epi16(sums, 4);
+    }
+    for(; i < string.size; ++i)
+    {
+        count += (string.str[i] & 0xc0) != 0x80;
+    }
+    return count;
+}
+
+internal String16
+String16FromString8(M_Arena *arena, String8 string)
+{
+    // NOTE(rjf): Never more UTF-16 units than UTF-8 bytes.
+    u64 max_size = string.size;
+    u16 *out = M_ArenaPushAligned(arena, (max_size + 1)*sizeof(u16), sizeof(u16));
+    u64 size = 0;
+    u64 i = 0;
+    __m128i zero = _mm_setzero_si128();
+    while(i < string.size)
+    {
+        if(i + 16 <= string.size)
+        {
+            __m128i x = _mm_loadu_si128((__m128i *)(string.str + i));
+            if(_mm_movemask_epi8(x) == 0)
+            {
+                _mm_storeu_si128((__m128i *)(out + size), _mm_unpacklo_epi8(x, zero));
+                _mm_storeu_si128((__m128i *)(out + size + 8), _mm_unpackhi_epi8(x, zero));
+                i += 16;
+                size += 16;
+                continue;
+            }
+        }
+        for(u64 block_end = Min(i + 16, string.size); i < block_end;)
+        {
+            if(string.str[i] < 0x80)
+            {
+                out[size++] = string.str[i++];
+            }
+            else
+            {
+                UnicodeDecode decode = UTF8DecodeCodepoint(string.str + i, string.size - i);
+                size += UTF16EncodeCodepoint(out + size, decode.codepoint);
+                i += decode.advance;
+            }
+        }
+    }
+    M_ArenaPop(arena, (max_size - size)*sizeof(u16));
+    out[size] = 0;
+    String16 result = { out, size };
+    return result;
+}
+
+internal String8
+String8FromString16(M_Arena *arena, String16 string)
+{
+    // NOTE(rjf): At most 3 bytes per unit; pairs take 4 bytes for 2 units.
+    u64 max_size = 3*string.size;
+    u8 *out = M_ArenaPush(arena, max_size + 1);
+    u64 size = 0;
+    u64 i = 0;
+    __m128i non_ascii_bits = _mm_set1_epi16((short)0xff80);
+    while(i < string.size)
+    {
+        if(i + 16 <= string.size)
+        {
+            __m128i a = _mm_loadu_si128((__m128i *)(string.str + i));
+            __m128i b = _mm_loadu_si128((__m128i *)(string.str + i + 8));
+            __m128i high = _mm_and_si128(_mm_or_si128(a, b), non_ascii_bits);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xffff)
+            {
+                _mm_storeu_si128((__m128i *)(out + size), _mm_packus_epi16(a, b));
+                i += 16;
+                size += 16;
+                continue;
+            }
+        }
+        for(u64 block_end = Min(i + 16, string.size); i < block_end;)
+        {
+            if(string.str[i] < 0x80)
+            {
+                out[size++] = (u8)string.str[i++];
+            }
+            else
+            {
+                UnicodeDecode decode = UTF16DecodeCodepoint(string.str + i, string.size - i);
+                size += UTF8EncodeCodepoint(out + size, decode.codepoint);
+                i += decode.advance;
+            }
+        }
+    }
+    M_ArenaPop(arena, max_size - size);
+    out[size] = 0;
+    return S8(out, size);
+}
+
+internal String32
+String32FromString8(M_Arena *arena, String8 string)
+{
+    u64 max_size = string.size;
+    u32 *out = M_ArenaPushAligned(arena, (max_size + 1)*sizeof(u32), sizeof(u32));
+    u64 size = 0;
+    u64 i = 0;
+    __m128i zero = _mm_setzero_si128();
+    while(i < string.size)
+    {
+        if(i + 16 <= string.size)
+        {
+            __m128i x = _mm_loadu_si128((__m128i *)(string.str + i));
+            if(_mm_movemask_epi8(x) == 0)
+            {
+                __m128i low = _mm_unpacklo_epi8(x, zero);
+                __m128i high = _mm_unpackhi_epi8(x, zero);
+                _mm_storeu_si128((__m128i *)(out + size + 0), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128((__m128i *)(out + size + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128((__m128i *)(out + size + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128((__m128i *)(out + size + 12), _mm_unpackhi_epi16(high, zero));
+                i += 16;
+                size += 16;
+                continue;
+            }
+        }
+        for(u64 block_end = Min(i + 16, string.size); i < block_end;)
+        {
+            if(string.str[i] < 0x80)
+            {
+                out[size++] = string.str[i++];
+            }
+            else
+            {
+                UnicodeDecode decode = UTF8DecodeCodepoint(string.str + i, string.size - i);
+                out[size++] = decode.codepoint;
+                i += decode.advance;
+            }
+        }
+    }
+    M_ArenaPop(arena, (max_size - size)*sizeof(u32));
+    out[size] = 0;
+    String32 result = { out, size };
+    return result;
+}
+
+internal String8
+String8FromString32(M_Arena *arena, String32 string)
+{
+    u64 max_size = 4*string.size;
+    u8 *out = M_ArenaPush(arena, max_size + 1);
+    u64 size = 0;
+    u64 i = 0;
+    __m128i non_ascii_bits = _mm_set1_epi32(~0x7f);
+    while(i < string.size)
+    {
+        if(i + 16 <= string.size)
+        {
+            __m128i a = _mm_loadu_si128((__m128i *)(string.str + i + 0));
+            __m128i b = _mm_loadu_si128((__m128i *)(string.str + i + 4));
+            __m128i c = _mm_loadu_si128((__m128i *)(string.str + i + 8));
+            __m128i d = _mm_loadu_si128((__m128i *)(string.str + i + 12));
+            __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+            __m128i high = _mm_and_si128(all, non_ascii_bits);
+            if(_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xffff)
+            {
+                __m128i ab = _mm_packs_epi32(a, b);
+                __m128i cd = _mm_packs_epi32(c, d);
+                _mm_storeu_si128((__m128i *)(out + size), _mm_packus_epi16(ab, cd));
+                i += 16;
+                size += 16;
+                continue;
+            }
+        }
+        for(u64 block_end = Min(i + 16, string.size); i < block_end; ++i)
+        {
+            if(string.str[i] < 0x80)
+            {
+                out[size++] = (u8)string.str[i];
+            }
+            else
+            {
+                size += UTF8EncodeCodepoint(out + size, string.str[i]);
+            }
+        }
+    }
+    M_ArenaPop(arena, max_size - size);
+    out[size] = 0;
+    return S8(out, size);
+}
+
+//~ NOTE(rjf): Splitting and Tokenizing
+
+// NOTE(rjf): Everything here returns slices of the input; nothing is copied.
+
+internal void
+StringCharSetAddRange(StringCharSet *set, u8 first, u8 last)
+{
+    for(u32 c = first; c <= last; ++c)
+    {
+        if(set->bitmap[c >> 3] & (1 << (c & 7)))
+        {
+            continue;
+        }
+        set->bitmap[c >> 3] |= (u8)(1 << (c & 7));
+        if(c < 0x80)
+        {
+            set->low_nibble_masks[c & 15] |= (u8)(1 << (c >> 4));
+            set->high_nibble_bits[c >> 4] = (u8)(1 << (c >> 4));
+        }
+        else
+        {
+            set->has_non_ascii = 1;
+        }
+        if(set->char_count < ArrayCount(set->chars))
+        {
+            set->chars[set->char_count] = (u8)c;
+        }
+        set->char_count += 1;
+    }
+}
+
+internal StringCharSet
+StringCharSetFromChars(String8 chars)
+{
+    StringCharSet set = {0};
+    for(u64 i = 0; i < chars.size; ++i)
+    {
+        StringCharSetAddRange(&set, chars.str[i], chars.str[i]);
+    }
+    return set;
+}
+
+internal b32
+StringCharSetHas(StringCharSet *set, u8 c)
+{
+    return !!(set->bitmap[c >> 3] & (1 << (c & 7)));
+}
+
+internal u64
+StringFindSetScalar(u8 *str, u64 start, u64 size, StringCharSet *set, b32 in_set)
+{
+    u64 i = start;
+    while(i < size && StringCharSetHas(set, str[i]) != in_set)
+    {
+        ++i;
+    }
+    return i;
+}
+
+internal u64
+StringFindSetSSE2(u8 *str, u64 start, u64 size, StringCharSet *set, b32 in_set)
+{
+    u64 i = start;
+    u32 flip = in_set ? 0 : 0xffff;
+    for(; i + 16 <= size; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((__m128i *)(str + i));
+        __m128i members = _mm_setzero_si128();
+        for(u32 c = 0; c < set->char_count; ++c)
+        {
+            members = _mm_or_si128(members, _mm_cmpeq_epi8(x, _mm_set1_epi8((char)set->chars[c])));
+        }
+        u32 hits = (u32)_mm_movemask_epi8(members) ^ flip;
+        if(hits)
+        {
+            return i + LowestSetBitU32(hits);
+        }
+    }
+    return StringFindSetScalar(str, i, size, set, in_set);
+}
+
+TARGET_AVX2 internal u64
+StringFindSetAVX2(u8 *str, u64 start, u64 size, StringCharSet *set, b32 in_set)
+{
+    __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)set->low_nibble_masks));
+    __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)set->high_nibble_bits));
+    __m256i nibble = _mm256_set1_epi8(0x0f);
+    u32 flip = in_set ? 0xffffffff : 0;
+    u64 i = start;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((__m256i *)(str + i));
+        __m256i low = _mm256_and_si256(x, nibble);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+        __m256i members = _mm256_and_si256(_mm256_shuffle_epi8(low_table, low),
+                                           _mm256_shuffle_epi8(high_table, high));
+        u32 outside = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(members, _mm256_setzero_si256()));
+        u32 hits = outside ^ flip;
+        if(hits)
+        {
+            return i + LowestSetBitU32(hits);
+        }
+    }
+    return StringFindSetScalar(str, i, size, set, in_set);
+}
+
+internal u64
+StringFindSet(String8 string, u64 start, StringCharSet *set, b32 in_set)
+{
+    u64 result = 0;
+    if(start >= string.size)
+    {
+        result = string.size;
+    }
+    else if(string.size - start >= 32 && !set->has_non_ascii && CPUHas(AVX2))
+    {
+        result = StringFindSetAVX2(string.str, start, string.size, set, in_set);
+    }
+    else if(string.size - start >= 16 && set->char_count <= ArrayCount(set->chars))
+    {
+        result = StringFindSetSSE2(string.str, start, string.size, set, in_set);
+    }
+    else
+    {
+        result = StringFindSetScalar(string.str, start, string.size, set, in_set);
+    }
+    return result;
+}
+
+// NOTE(rjf): Both return string.size when there's no such byte.
+internal u64
+StringFindFirstInSet(String8 string, u64 start, StringCharSet *set)
+{
+    return StringFindSet(string, start, set, 1);
+}
+
+internal u64
+StringFindFirstNotInSet(String8 string, u64 start, StringCharSet *set)
+{
+    return StringFindSet(string, start, set, 0);
+}
+
+internal StringSplitIterator
+StringSplitBegin(String8 string, StringCharSet *delimiters, StringSplitFlags flags)
+{
+    StringSplitIterator iterator = {0};
+    iterator.string = string;
+    iterator.delimiters = delimiters;
+    iterator.flags = flags;
+    return iterator;
+}
+
+// NOTE(rjf): Without SkipEmpty, n delimiters give n + 1 pieces, some of
+// which may be empty.
+internal b32
+StringSplitNext(StringSplitIterator *iterator, String8 *piece)
+{
+    b32 result = 0;
+    if(!iterator->done)
+    {
+        String8 string = iterator->string;
+        u64 start = iterator->position;
+        if(iterator->flags & StringSplitFlag_SkipEmpty)
+        {
+            start = StringFindFirstNotInSet(string, start, iterator->delimiters);
+        }
+        if(start >= string.size && (iterator->flags & StringSplitFlag_SkipEmpty))
+        {
+            iterator->done = 1;
+        }
+        else
+        {
+            u64 end = StringFindFirstInSet(string, start, iterator->delimiters);
+            *piece = S8(string.str + start, end - start);
+            iterator->position = end + 1;
+            iterator->done = end >= string.size;
+            result = 1;
+        }
+    }
+    return result;
+}
+
+internal StringLineIterator
+StringLinesBegin(String8 string)
+{
+    StringLineIterator iterator = {0};
+    iterator.string = string;
+    return iterator;
+}
+
+internal String8
+StringTrimLineEnding(String8 line)
+{
+    if(line.size && line.str[line.size - 1] == '\n')
+    {
+        line.size -= 1;
+    }
+    if(line.size && line.str[line.size - 1] == '\r')
+    {
+        line.size -= 1;
+    }
+    return line;
+}
+
+// NOTE(rjf): Lines end at \n, and a \r before it is dropped. A final line
+// ending doesn't start another, empty line.
+internal b32
+StringLinesNext(StringLineIterator *iterator, String8 *line)
+{
+    b32 result = 0;
+    String8 string = iterator->string;
+    u64 start = iterator->position;
+    if(start < string.size)
+    {
+        u8 *newline = memchr(string.str + start, '\n', string.size - start);
+        u64 end = newline ? (u64)(newline - string.str) + 1 : string.size;
+        *line = StringTrimLineEnding(S8(string.str + start, end - start));
+        iterator->position = end;
+        result = 1;
+    }
+    return result;
+}
+
+// NOTE(rjf): Start of the first line at or after offset, for splitting a
+// buffer into chunks that parse independently.
+internal u64
+StringNextLineStart(String8 string, u64 offset)
+{
+    u64 result = string.size;
+    if(offset == 0)
+    {
+        result = 0;
+    }
+    else if(offset <= string.size)
+    {
+        u8 *newline = memchr(string.str + offset - 1, '\n', string.size - (offset - 1));
+        result = newline ? (u64)(newline - string.str) + 1 : string.size;
+    }
+    return result;
+}
+
+internal u64 *
+StringLineIndexPushNewlines(M_Array *line_starts, u64 base, u32 newline_mask)
+{
+    M_ArrayReserve(line_starts, line_starts->count + 32);
+    u64 *out = (u64 *)line_starts->data + line_starts->count;
+    while(newline_mask)
+    {
+        *out++ = base + LowestSetBitU32(newline_mask) + 1;
+        newline_mask &= newline_mask - 1;
+    }
+    line_starts->count = out - (u64 *)line_starts->data;
+    return out;
+}
+
+internal u64
+StringLineIndexScanSSE2(M_Array *line_starts, String8 string)
+{
+    __m128i newline = _mm_set1_epi8('\n');
+    u64 i = 0;
+    for(; i + 16 <= string.size; i += 16)
+    {
+        __m128i x = _mm_loadu_si128((__m128i *)(string.str + i));
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(x, newline));
+        if(mask)
+        {
+            StringLineIndexPushNewlines(line_starts, i, mask);
+        }
+    }
+    return i;
+}
+
+TARGET_AVX2 internal u64
+StringLineIndexScanAVX2(M_Array *line_starts, String8 string)
+{
+    __m256i newline = _mm256_set1_epi8('\n');
+    u64 i = 0;
+    for(; i + 32 <= string.size; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256((__m256i *)(string.str + i));
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, newline));
+        if(mask)
+        {
+            StringLineIndexPushNewlines(line_starts, i, mask);
+        }
+    }
+    return i;
+}
+
+// NOTE(rjf): One pass over the buffer, recording where every line starts.
+// After that, StringLineFromIndex is O(1), and line_starts gives parallel
+// parsers their split points.
+internal StringLineIndex
+StringBuildLineIndex(M_Arena *arena, String8 string)
+{
+    M_Array line_starts = M_ArrayInitializeForType(arena, u64, 0);
+    if(string.size)
+    {
+        *M_ArrayPushType(&line_starts, u64) = 0;
+        u64 i = 0;
+        if(CPUHas(AVX2))
+        {
+            i = StringLineIndexScanAVX2(&line_starts, string);
+        }
+        else
+        {
+            i = StringLineIndexScanSSE2(&line_starts, string);
+        }
+        for(; i < string.size; ++i)
+        {
+            if(string.str[i] == '\n')
+            {
+                *M_ArrayPushType(&line_starts, u64) = i + 1;
+            }
+        }
+        
+        // NOTE(rjf): A trailing newline ends the last line; it doesn't start
+        // a new one. Either way, the final entry becomes the end sentinel.
+        if(M_ArrayAt(&line_starts, u64, line_starts.count - 1) != string.size)
+        {
+            *M_ArrayPushType(&line_starts, u64) = string.size;
+        }
+    }
+    M_ArrayShrinkToFit(&line_starts);
+    
+    StringLineIndex index = {0};
+    index.line_starts = (u64 *)line_starts.data;
+    index.line_count = line_starts.count ? line_starts.count - 1 : 0;
+    return index;
+}
+
+internal String8
+StringLineFromIndex(String8 string, StringLineIndex *index, u64 line)
+{
+    String8 result = {0};
+    if(line < index->line_count)
+    {
+        u64 start = index->line_starts[line];
+        u64 end = index->line_starts[line + 1];
+        result = StringTrimLineEnding(S8(string.str + start, end - start));
+    }
+    return result;
+}
+
+global StringCharSet global_token_space_set;
+global StringCharSet global_token_identifier_set;
+global StringCharSet global_token_number_set;
+global StringCharSet global_token_string_set[2];
+global b32 global_token_sets_initialized;
+
+internal void
+StringTokenizerInitializeSets(void)
+{
+    StringCharSetAddRange(&global_token_space_set, 0, 32);
+    
+    StringCharSetAddRange(&global_token_identifier_set, 'a', 'z');
+    StringCharSetAddRange(&global_token_identifier_set, 'A', 'Z');
+    StringCharSetAddRange(&global_token_identifier_set, '0', '9');
+    StringCharSetAddRange(&global_token_identifier_set, '_', '_');
+    
+    global_token_number_set = global_token_identifier_set;
+    StringCharSetAddRange(&global_token_number_set, '.', '.');
+    
+    global_token_string_set[0] = StringCharSetFromChars(S8Lit("\"\\"));
+    global_token_string_set[1] = StringCharSetFromChars(S8Lit("'\\"));
+    global_token_sets_initialized = 1;
+}
+
+internal StringTokenizer
+StringTokenizerBegin(String8 string)
+{
+    if(!global_token_sets_initialized)
+    {
+        StringTokenizerInitializeSets();
+    }
+    StringTokenizer tokenizer = {0};
+    tokenizer.string = string;
+    return tokenizer;
+}
+
+// NOTE(rjf): Skips whitespace (CharIsSpace), then reads one token:
+// identifiers are [A-Za-z_][A-Za-z0-9_]*; numbers start with a digit and
+// run over letters, digits, _ and . (plus a sign after an exponent e);
+// strings are quoted with " or ' and include their quotes and escapes;
+// any other ASCII byte is a one-byte symbol, and anything else is one
+// UTF-8 code point of kind Other.
+internal b32
+StringTokenizerNext(StringTokenizer *tokenizer, StringToken *token)
+{
+    String8 string = tokenizer->string;
+    u64 start = StringFindFirstNotInSet(string, tokenizer->position, &global_token_space_set);
+    u64 end = start;
+    StringTokenKind kind = StringTokenKind_Null;
+    if(start < string.size)
+    {
+        u8 c = string.str[start];
+        if(CharIsAlpha(c) || c == '_')
+        {
+            kind = StringTokenKind_Identifier;
+            end = StringFindFirstNotInSet(string, start + 1, &global_token_identifier_set);
+        }
+        else if(CharIsDigit(c))
+        {
+            kind = StringTokenKind_Number;
+            b32 hex = c == '0' && start + 1 < string.size && CharToLower(string.str[start + 1]) == 'x';
+            end = StringFindFirstNotInSet(string, start + 1, &global_token_number_set);
+            while(!hex && end < string.size && (string.str[end] == '+' || string.str[end] == '-') &&
+                  CharToLower(string.str[end - 1]) == 'e')
+            {
+                end = StringFindFirstNotInSet(string, end + 1, &global_token_number_set);
+            }
+        }
+        else if(c == '"' || c == '\'')
+        {
+            kind = StringTokenKind_String;
+            StringCharSet *stops = &global_token_string_set[c == '\''];
+            end = start + 1;
+            for(;;)
+            {
+                end = StringFindFirstInSet(string, end, stops);
+                if(end >= string.size)
+                {
+                    break;
+                }
+                if(string.str[end] == c)
+                {
+                    end += 1;
+                    break;
+                }
+                end += 2;
+            }
+            end = Min(end, string.size);
+        }
+        else if(c < 0x80)
+        {
+            kind = StringTokenKind_Symbol;
+            end = start + 1;
+        }
+        else
+        {
+            kind = StringTokenKind_Other;
+            end = start + UTF8DecodeCodepoint(string.str + start, string.size - start).advance;
+        }
+    }
+    token->kind = kind;
+    token->offset = start;
+    token->string = S8(string.str + start, end - start);
+    tokenizer->position = end;
+    return kind != StringTokenKind_Null;
+}
+
+//~ NOTE(rjf): Fuzzy Matching
+
+// NOTE(rjf): Letters get a bit each, digits share five bits, and everything
+// else shares the last one. Collisions only make the prefilter let more
+// candidates through to scoring.
+internal u32
+StringFuzzyCharMask(u8 c)
+{
+    u32 result = 0;
+    c = CharToLower(c);
+    if(c >= 'a' && c <= 'z')
+    {
+        result = 1u << (c - 'a');
+    }
+    else if(c >= '0' && c <= '9')
+    {
+        result = 1u << (26 + (c - '0') / 2);
+    }
+    else
+    {
+        result = 1u << 31;
+    }
+    return result;
+}
+
+internal u32
+StringFuzzyMaskFromString(String8 string)
+{
+    u32 result = 0;
+    for(u64 i = 0; i < string.size; ++i)
+    {
+        result |= StringFuzzyCharMask(string.str[i]);
+    }
+    return result;
+}
+
+// NOTE(rjf): Matches that start a word score higher: the start of the
+// string, after a separator, a lower-to-upper case change, or the first
+// digit after a non-digit.
+internal i32
+StringFuzzyBoundaryBonus(String8 candidate, u64 i)
+{
+    i32 bonus = 0;
+    if(i == 0)
+    {
+        bonus = 10;
+    }
+    else
+    {
+        u8 previous = candidate.str[i - 1];
+        u8 c = candidate.str[i];
+        if(previous == ' ' || previous == '_' || previous == '-' || previous == '.' ||
+           previous == '/' || previous == '\\' || previous == ':')
+        {
+            bonus = 8;
+        }
+        else if(previous >= 'a' && previous <= 'z' && c >= 'A' && c <= 'Z')
+        {
+            bonus = 7;
+        }
+        else if(!CharIsDigit(previous) && CharIsDigit(c))
+        {
+            bonus = 7;
+        }
+    }
+    return bonus;
+}
+
+// NOTE(rjf): Returns 0 when query (already lowercase) isn't a subsequence
+// of candidate. Otherwise the match is narrowed to the shortest window that
+// ends at the first complete match, and scored: each matched character is
+// worth 16 plus its boundary bonus (doubled for the first query character,
+// and at least 4 inside a run of consecutive matches); each skipped
+// character inside the window costs 3 to open a gap and 1 to extend it.
+internal b32
+StringFuzzyScore(String8 candidate, u8 *query, u64 query_size, i32 *score_out)
+{
+    b32 matched = 0;
+    i32 score = 0;
+    if(query_size <= candidate.size)
+    {
+        u64 query_index = 0;
+        u64 end = 0;
+        for(u64 i = 0; i < candidate.size && query_index < query_size; ++i)
+        {
+            if((u8)CharToLower(candidate.str[i]) == query[query_index])
+            {
+                query_index += 1;
+                end = i + 1;
+            }
+        }
+        
+        if(query_index == query_size)
+        {
+            u64 start = end;
+            for(u64 i = end; i > 0 && query_index > 0; --i)
+            {
+                if((u8)CharToLower(candidate.str[i - 1]) == query[query_index - 1])
+                {
+                    query_index -= 1;
+                    start = i - 1;
+                }
+            }
+            
+            matched = 1;
+            i32 run_bonus = 0;
+            b32 in_run = 0;
+            b32 in_gap = 0;
+            for(u64 i = start; i < end && query_index < query_size; ++i)
+            {
+                if((u8)CharToLower(candidate.str[i]) == query[query_index])
+                {
+                    i32 bonus = StringFuzzyBoundaryBonus(candidate, i);
+                    if(in_run)
+                    {
+                        bonus = Max(bonus, Max(run_bonus, 4));
+                    }
+                    else
+                    {
+                        run_bonus = bonus;
+                    }
+                    if(query_index == 0)
+                    {
+                        bonus *= 2;
+                    }
+                    score += 16 + bonus;
+                    query_index += 1;
+                    in_run = 1;
+                    in_gap = 0;
+                }
+                else
+                {
+                    score -= in_gap ? 1 : 3;
+                    in_run = 0;
+                    in_gap = 1;
+                }
+            }
+        }
+    }
+    *score_out = score;
+    return matched;
+}
+
+internal u32
+StringFuzzyScoreCandidate(StringFuzzyMatcher *matcher, u32 index, StringFuzzyMatch *matches, u32 match_count)
+{
+    i32 score = 0;
+    if(StringFuzzyScore(matcher->candidates[index], matcher->query, matcher->query_size, &score))
+    {
+        matches[match_count].index = index;
+        matches[match_count].score = score;
+        match_count += 1;
+    }
+    return match_count;
+}
+
+// NOTE(rjf): The full scans test 4 (SSE2) or 8 (AVX2) candidate masks at a
+// time, and only candidates with every query bit go on to be scored.
+internal u32
+StringFuzzyScanSSE2(StringFuzzyMatcher *matcher, u32 query_mask, StringFuzzyMatch *matches, u32 *match_count)
+{
+    __m128i query = _mm_set1_epi32((i32)query_mask);
+    u32 count = *match_count;
+    u32 i = 0;
+    for(; i + 4 <= matcher->candidate_count; i += 4)
+    {
+        __m128i masks = _mm_loadu_si128((__m128i *)(matcher->char_masks + i));
+        __m128i missing = _mm_andnot_si128(masks, query);
+        u32 hits = (u32)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(missing, _mm_setzero_si128())));
+        while(hits)
+        {
+            count = StringFuzzyScoreCandidate(matcher, i + LowestSetBitU32(hits), matches, count);
+            hits &= hits - 1;
+        }
+    }
+    *match_count = count;
+    return i;
+}
+
+TARGET_AVX2 internal u32
+StringFuzzyScanAVX2(StringFuzzyMatcher *matcher, u32 query_mask, StringFuzzyMatch *matches, u32 *match_count)
+{
+    __m256i query = _mm256_set1_epi32((i32)query_mask);
+    u32 count = *match_count;
+    u32 i = 0;
+    for(; i + 8 <= matcher->candidate_count; i += 8)
+    {
+        __m256i masks = _mm256_loadu_si256((__m256i *)(matcher->char_masks + i));
+        __m256i missing = _mm256_andnot_si256(masks, query);
+        u32 hits = (u32)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(missing, _mm256_setzero_si256())));
+        while(hits)
+        {
+            count = StringFuzzyScoreCandidate(matcher, i + LowestSetBitU32(hits), matches, count);
+            hits &= hits - 1;
+        }
+    }
+    *match_count = count;
+    return i;
+}
+
+// NOTE(rjf): The matcher keeps pointing at candidates; they have to outlive
+// it, unchanged.
+internal StringFuzzyMatcher
+StringFuzzyMatcherInitialize(String8 *candidates, u32 candidate_count)
+{
+    StringFuzzyMatcher matcher = {0};
+    matcher.candidates = candidates;
+    matcher.candidate_count = candidate_count;
+    matcher.arena = M_ArenaInitialize();
+    matcher.char_masks = M_PushArray(&matcher.arena, u32, candidate_count);
+    for(u32 i = 0; i < candidate_count; ++i)
+    {
+        matcher.char_masks[i] = StringFuzzyMaskFromString(candidates[i]);
+    }
+    matcher.level_count = 1;
+    matcher.levels[0].arena_position = matcher.arena.alloc_position;
+    matcher.levels[0].match_count = candidate_count;
+    return matcher;
+}
+
+internal void
+StringFuzzyMatcherRelease(StringFuzzyMatcher *matcher)
+{
+    M_ArenaRelease(&matcher->arena);
+    MemorySet(matcher, 0, sizeof(*matcher));
+}
+
+internal void
+StringFuzzyMatcherPushLevel(StringFuzzyMatcher *matcher)
+{
+    StringFuzzyLevel *parent = &matcher->levels[matcher->level_count - 1];
+    StringFuzzyLevel *level = &matcher->levels[matcher->level_count++];
+    level->query_size = matcher->query_size;
+    level->arena_position = matcher->arena.alloc_position;
+    level->matches = M_PushArray(&matcher->arena, StringFuzzyMatch, parent->match_count);
+    level->match_count = 0;
+    
+    u32 query_mask = StringFuzzyMaskFromString(S8(matcher->query, matcher->query_size));
+    if(parent->matches)
+    {
+        for(u32 i = 0; i < parent->match_count; ++i)
+        {
+            u32 index = parent->matches[i].index;
+            if(!(query_mask & ~matcher->char_masks[index]))
+            {
+                level->match_count = StringFuzzyScoreCandidate(matcher, index, level->matches, level->match_count);
+            }
+        }
+    }
+    else
+    {
+        u32 i = 0;
+        if(CPUHas(AVX2))
+        {
+            i = StringFuzzyScanAVX2(matcher, query_mask, level->matches, &level->match_count);
+        }
+        else
+        {
+            i = StringFuzzyScanSSE2(matcher, query_mask, level->matches, &level->match_count);
+        }
+        for(; i < matcher->candidate_count; ++i)
+        {
+            if(!(query_mask & ~matcher->char_masks[i]))
+            {
+                level->match_count = StringFuzzyScoreCandidate(matcher, i, level->matches, level->match_count);
+            }
+        }
+    }
+    
+    // NOTE(rjf): Hand back the part of the block the matches didn't use.
+    M_ArenaPop(&matcher->arena, (u64)(parent->match_count - level->match_count)*sizeof(StringFuzzyMatch));
+}
+
+// NOTE(rjf): Returns how many candidates match. Only the levels for queries
+// that aren't a prefix of the new one are thrown away, so both typing and
+// deleting at the end of the query reuse earlier work. Queries longer than
+// STRING_FUZZY_QUERY_MAX bytes are cut off there.
+internal u32
+StringFuzzyMatcherSetQuery(StringFuzzyMatcher *matcher, String8 query)
+{
+    u64 query_size = Min(query.size, (u64)STRING_FUZZY_QUERY_MAX);
+    u64 common_size = 0;
+    while(common_size < query_size && common_size < matcher->query_size &&
+          (u8)CharToLower(query.str[common_size]) == matcher->query[common_size])
+    {
+        common_size += 1;
+    }
+    for(u64 i = common_size; i < query_size; ++i)
+    {
+        matcher->query[i] = CharToLower(query.str[i]);
+    }
+    matcher->query_size = query_size;
+    
+    while(matcher->levels[matcher->level_count - 1].query_size > common_size)
+    {
+        matcher->level_count -= 1;
+        StringFuzzyLevel *level = &matcher->levels[matcher->level_count];
+        M_ArenaPop(&matcher->arena, matcher->arena.alloc_position - level->arena_position);
+    }
+    if(matcher->levels[matcher->level_count - 1].query_size < query_size)
+    {
+        StringFuzzyMatcherPushLevel(matcher);
+    }
+    return matcher->levels[matcher->level_count - 1].match_count;
+}
+
+// NOTE(rjf): Higher score first, then the shorter candidate, then the
+// earlier one.
+internal b32
+StringFuzzyMatchIsBetter(StringFuzzyMatcher *matcher, StringFuzzyMatch a, StringFuzzyMatch b)
+{
+    b32 result = 0;
+    if(a.score != b.score)
+    {
+        result = a.score > b.score;
+    }
+    else
+    {
+        u64 a_size = matcher->candidates[a.index].size;
+        u64 b_size = matcher->candidates[b.index].size;
+        result = a_size != b_size ? a_size < b_size : a.index < b.index;
+    }
+    return result;
+}
+
+internal void
+StringFuzzyHeapSiftDown(StringFuzzyMatcher *matcher, StringFuzzyMatch *heap, u32 count, u32 i)
+{
+    for(;;)
+    {
+        u32 worst = i;
+        u32 left = 2*i + 1;
+        u32 right = left + 1;
+        if(left < count && StringFuzzyMatchIsBetter(matcher, heap[worst], heap[left]))
+        {
+            worst = left;
+        }
+        if(right < count && StringFuzzyMatchIsBetter(matcher, heap[worst], heap[right]))
+        {
+            worst = right;
+        }
+        if(worst == i)
+        {
+            break;
+        }
+        StringFuzzyMatch swap = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = swap;
+        i = worst;
+    }
+}
+
+// NOTE(rjf): Best max_count matches for the current query, best first, as an
+// M_Array of StringFuzzyMatch. A heap of the max_count best seen so far
+// (worst on top) keeps this O(n log k) rather than sorting every match.
+internal M_Array
+StringFuzzyMatcherTopK(M_Arena *arena, StringFuzzyMatcher *matcher, u32 max_count)
+{
+    StringFuzzyLevel *level = &matcher->levels[matcher->level_count - 1];
+    u32 count = Min(max_count, level->match_count);
+    M_Array result = M_ArrayInitializeForType(arena, StringFuzzyMatch, count);
+    StringFuzzyMatch *heap = (StringFuzzyMatch *)result.data;
+    
+    u32 heap_count = 0;
+    for(u32 i = 0; i < level->match_count && count; ++i)
+    {
+        StringFuzzyMatch match = {i, 0};
+        if(level->matches)
+        {
+            match = level->matches[i];
+        }
+        if(heap_count < count)
+        {
+            // NOTE(rjf): Sift up.
+            u32 j = heap_count++;
+            while(j > 0 && StringFuzzyMatchIsBetter(matcher, heap[(j - 1) / 2], match))
+            {
+                heap[j] = heap[(j - 1) / 2];
+                j = (j - 1) / 2;
+            }
+            heap[j] = match;
+        }
+        else if(StringFuzzyMatchIsBetter(matcher, match, heap[0]))
+        {
+            heap[0] = match;
+            StringFuzzyHeapSiftDown(matcher, heap, heap_count, 0);
+        }
+    }
+    
+    // NOTE(rjf): Popping the worst to the back leaves the heap sorted best
+    // first.
+    for(u32 n = heap_count; n > 1; --n)
+    {
+        StringFuzzyMatch swap = heap[0];
+        heap[0] = heap[n - 1];
+        heap[n - 1] = swap;
+        StringFuzzyHeapSiftDown(matcher, heap, n - 1, 0);
+    }
+    result.count = heap_count;
+    return result;
+}
+
+internal void
+CopySubstringToStringUntilCharN(char *str1, u32 str1_max,
+                                const char *str2, char str2_term)
+{
+    u32 write_pos = 0;
+    while(1)
+    {
+        if(str2[write_pos] == str2_term || write_pos == str1_max - 1)
+        {
+            str1[write_pos++] = 0;
+            break;
+        }
+        else
+        {
+            str1[write_pos] = str2[write_pos];
+            ++write_pos;
+        }
+    }
+}
+
+internal void
+CopyStringToFixedSizeBuffer(char *dest, u32 dest_max,
+                            const char *src)
+{
+    u32 read_pos = 0;
+    u32 write_pos = 0;
+    for(;;)
+    {
+        if(src[read_pos] == 0 || write_pos >= dest_max)
+        {
+            break;
+        }
+        dest[write_pos++] = src[read_pos++];
+    }
+    if(write_pos >= dest_max)
+    {
+        dest[dest_max - 1] = 0;
+    }
+    else
+    {
+        dest[write_pos++] = 0;
+    }
+}
+
+internal u32
+CStringIndexAfterSubstring(char *str, char *substr)
+{
+    u32 result = 0;
+    String8 string = String8FromCString(str);
+    String8 substring = String8FromCString(substr);
+    u64 index = StringFindSubstringReverse(string, substring, StringMatchFlag_CaseInsensitive);
+    if(index < string.size)
+    {
+        result = (u32)(index + substring.size);
+    }
+    return result;
+}
+
+internal u32
+CStringFirstIndexAfterSubstring(char *str, char *substr)
+{
+    u32 result = 0;
+    String8 string = String8FromCString(str);
+    String8 substring = String8FromCString(substr);
+    u64 index = StringFindSubstring(string, substring, 0, StringMatchFlag_CaseInsensitive);
+    if(substring.size && index < string.size)
+    {
+        result = (u32)(index + substring.size);
+    }
+    return result;
+}
+
+internal void
+CopyCStringToFixedSizeBuffer(char *destination, u32 destination_max, char *source)
+{
+    for(u32 i = 0; i < destination_max; ++i)
+    {
+        destination[i] = source[i];
+        if(source[i] == 0)
+        {
+            break;
+        }
+    }
+    destination[destination_max-1] = 0;
+}
+
+internal void
+CopyCStringToFixedSizeBufferN(char *destination, u32 destination_max, char *source, u32 source_max)
+{
+    for(u32 i = 0; i < destination_max && i < source_max; ++i)
+    {
+        destination[i] = source[i];
+        if(source[i] == 0)
+        {
+            break;
+        }
+    }
+    destination[destination_max-1] = 0;
+}
+
+internal char *
+ConvertCStringToLowercase(char *str)
+{
+    ConvertStringToLowercase(String8FromCString(str));
+    return str;
+}
+
+internal char *
+ConvertCStringToUppercase(char *str)
+{
+    ConvertStringToUppercase(String8FromCString(str));
+    return str;
+}
+
+internal char *
+ConvertCStringToLowercaseWithUnderscores(char *str)
+{
+    for(int i = 0; str[i]; ++i)
+    {
+        if(str[i] == ' ')
+        {
+            str[i] = '_';
+        }
+        else
+        {
+            str[i] = CharToLower(str[i]);
+        }
+    }
+    return str;
+}
+
+static unsigned int global_crc32_table[] =
+{
+    0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9,
+    0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
+    0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
+    0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
+    0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9,
+    0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
+    0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011,
+    0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
+    0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
+    0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
+    0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81,
+    0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
+    0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49,
+    0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
+    0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
+    0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
+    0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae,
+    0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
+    0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16,
+    0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
+    0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
+    0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
+    0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066,
+    0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
+    0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e,
+    0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
+    0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
+    0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
+    0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e,
+    0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
+    0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686,
+    0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
+    0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
+    0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
+    0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f,
+    0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
+    0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47,
+    0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
+    0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
+    0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
+    0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7,
+    0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
+    0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f,
+    0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
+    0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
+    0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
+    0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f,
+    0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
+    0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640,
+    0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
+    0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
+    0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
+    0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30,
+    0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
+    0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088,
+    0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
+    0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
+    0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
+    0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18,
+    0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
+    0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0,
+    0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
+    0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
+    0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4,
+};
+
+internal u32
+CStringCRC32N(char *name, u32 n)
+{
+    u32 crc = 0;
+    for(u32 i = 0; name[i] && i < n; ++i)
+    {
+        crc = (crc << 8) ^ global_crc32_table[((crc >> 24) ^ name[i]) & 255];
+    }
+    return crc;
+}
+
+internal u32
+CStringCRC32(char *name)
+{
+    return CStringCRC32N(name, (u32)(u32)(-1));
+}
+
+// NOTE(rjf): The table above is the non-reflected 0x04c11db7 CRC with a zero
+// initial value and no final xor. It's kept as is so existing checksums
+// don't change; this is the same thing over a byte range, NULs included.
+internal u32
+CRC32Legacy(String8 string)
+{
+    u32 crc = 0;
+    for(u64 i = 0; i < string.size; ++i)
+    {
+        crc = (crc << 8) ^ global_crc32_table[((crc >> 24) ^ string.str[i]) & 255];
+    }
+    return crc;
+}
+
+//~ NOTE(rjf): CRC32
+
+// NOTE(rjf): Standard reflected CRC-32 (0xedb88320, as used by zlib, PNG and
+// Ethernet). For streaming, CRC32Begin a state, CRC32Update it with each
+// chunk in order, and CRC32Finish it; CRC32 does all three for one range.
+// Updates fold 64-byte blocks with carry-less multiplies when the CPU has
+// PCLMUL, and otherwise use slicing-by-8 tables.
+
+global u32 global_crc32_slice_tables[8][256];
+global volatile u32 global_crc32_slice_tables_ready = 0;
+
+internal void
+CRC32InitializeTables(void)
+{
+    for(u32 i = 0; i < 256; ++i)
+    {
+        u32 crc = i;
+        for(u32 bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+        }
+        global_crc32_slice_tables[0][i] = crc;
+    }
+    for(u32 i = 0; i < 256; ++i)
+    {
+        for(u32 slice = 1; slice < 8; ++slice)
+        {
+            u32 previous = global_crc32_slice_tables[slice-1][i];
+            global_crc32_slice_tables[slice][i] = (previous >> 8) ^ global_crc32_slice_tables[0][previous & 255];
+        }
+    }
+    AtomicStoreU32(&global_crc32_slice_tables_ready, 1);
+}
+
+internal u32
+CRC32UpdateSlicing(u32 crc, u8 *data, u64 size)
+{
+    u32 (*t)[256] = global_crc32_slice_tables;
+    for(; size >= 8; data += 8, size -= 8)
+    {
+        u32 one, two;
+        MemoryCopy(&one, data, 4);
+        MemoryCopy(&two, data + 4, 4);
+        one ^= crc;
+        crc = (t[7][one & 255] ^ t[6][(one >> 8) & 255] ^ t[5][(one >> 16) & 255] ^ t[4][one >> 24] ^
+               t[3][two & 255] ^ t[2][(two >> 8) & 255] ^ t[1][(two >> 16) & 255] ^ t[0][two >> 24]);
+    }
+    for(; size > 0; ++data, --size)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *data) & 255];
+    }
+    return crc;
+}
+
+// NOTE(rjf): Folds four 128-bit lanes across 64-byte blocks, then down to one
+// lane, then Barrett-reduces to 32 bits. The constants are powers of x modulo
+// the polynomial, as in Intel's "Fast CRC Computation Using PCLMULQDQ". size
+// must be a multiple of 16, and at least 64.
+TARGET_PCLMUL internal u32
+CRC32UpdatePCLMUL(u32 crc, u8 *data, u64 size)
+{
+    __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+    __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    
+    __m128i x1 = _mm_loadu_si128((__m128i *)(data + 0x00));
+    __m128i x2 = _mm_loadu_si128((__m128i *)(data + 0x10));
+    __m128i x3 = _mm_loadu_si128((__m128i *)(data + 0x20));
+    __m128i x4 = _mm_loadu_si128((__m128i *)(data + 0x30));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    data += 64;
+    size -= 64;
+    
+    for(; size >= 64; data += 64, size -= 64)
+    {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((__m128i *)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((__m128i *)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((__m128i *)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((__m128i *)(data + 0x30)));
+    }
+    
+    // NOTE(rjf): Fold the four lanes into one, then any remaining 16-byte
+    // blocks into that.
+    __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+    for(; size >= 16; data += 16, size -= 16)
+    {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((__m128i *)data)), x5);
+    }
+    
+    // NOTE(rjf): 128 bits down to 64.
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    
+    // NOTE(rjf): Barrett reduction down to 32.
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return (u32)_mm_extract_epi32(x1, 1);
+}
+
+internal u32
+CRC32Begin(void)
+{
+    return 0xffffffff;
+}
+
+internal u32
+CRC32Update(u32 crc, void *data, u64 size)
+{
+    u8 *bytes = (u8 *)data;
+    if(size >= 64 && CPUHas(PCLMUL))
+    {
+        u64 folded_size = size & ~(u64)15;
+        crc = CRC32UpdatePCLMUL(crc, bytes, folded_size);
+        bytes += folded_size;
+        size -= folded_size;
+    }
+    if(size > 0)
+    {
+        if(!AtomicLoadU32(&global_crc32_slice_tables_ready))
+        {
+            CRC32InitializeTables();
+        }
+        crc = CRC32UpdateSlicing(crc, bytes, size);
+    }
+    return crc;
+}
+
+internal u32
+CRC32Finish(u32 crc)
+{
+    return ~crc;
+}
+
+internal u32
+CRC32(String8 string)
+{
+    return CRC32Finish(CRC32Update(CRC32Begin(), string.str, string.size));
+}
+
+//~ NOTE(rjf): Hashing
+
+// NOTE(rjf): Seeded 64-bit hash for hash tables and the like; not for
+// anything security related. Keys up to 1K go through wyhash (final
+// version 4). Longer inputs are consumed in 64-byte stripes by eight 64-bit
+// SIMD accumulators in the style of XXH3, each stripe keyed by a sliding
+// window of a fixed secret, and scrambled every 16 stripes. The SSE2 and
+// AVX2 paths compute the same value.
+
+#define HASH_LONG_THRESHOLD     1024
+#define HASH_STRIPE_SIZE        64
+#define HASH_STRIPES_PER_BLOCK  16
+
+global u64 global_hash_wy_secret[4] =
+{
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+global u64 global_hash_long_secret[24] =
+{
+    0x51c9bc701e7ea419ull, 0xf38b2ffc80a4df5bull, 0xa5aec7978306d03bull, 0xf3f49249dc28ff91ull,
+    0xe255accb1a466885ull, 0xe512148239292d23ull, 0x9f19950499dd251dull, 0x6bad6be28e7aa6e9ull,
+    0x9293de8fc88b2875ull, 0xd7a7a3cc8c3d5f17ull, 0xc6cd75e9bb049a79ull, 0x7dabe929c4a334bfull,
+    0xc5e818fac0433cbdull, 0x70eb9a0a96263ae7ull, 0x00a61f933d6c51e3ull, 0x14aa4e719d3c7dedull,
+    0x498893101c593af5ull, 0x1919e93ad11745adull, 0x02f0ee99731c9453ull, 0xe4163207d0944997ull,
+    0x7d836e77af67d461ull, 0x5071950eadec6f11ull, 0x65b00a2d35d14881ull, 0x59001ac9406329bdull,
+};
+
+internal u64
+HashRead64(u8 *p)
+{
+    u64 v;
+    MemoryCopy(&v, p, 8);
+    return v;
+}
+
+internal u64
+HashRead32(u8 *p)
+{
+    u32 v;
+    MemoryCopy(&v, p, 4);
+    return v;
+}
+
+// NOTE(rjf): 64x64 -> 128-bit multiply, folded back to 64 bits with an xor.
+internal u64
+HashMix(u64 a, u64 b)
 {
-    va_list args;
-    va_start(args, fmt);
-    String8 result = PushStringFV(arena, fmt, args);
-    va_end(args);
-    return(result);
+#if _MSC_VER
+    u64 high = 0;
+    u64 low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    unsigned __int128 product = (unsigned __int128)a * b;
+    return (u64)product ^ (u64)(product >> 64);
+#endif
 }
 
-static unsigned int global_crc32_table[] =
+internal u64
+HashShort(u8 *p, u64 size, u64 seed)
 {
-    0x00000000, 0x04c11db7, 0x09823b6e, 0x0d4326d9,
-    0x130476dc, 0x17c56b6b, 0x1a864db2, 0x1e475005,
-    0x2608edb8, 0x22c9f00f, 0x2f8ad6d6, 0x2b4bcb61,
-    0x350c9b64, 0x31cd86d3, 0x3c8ea00a, 0x384fbdbd,
-    0x4c11db70, 0x48d0c6c7, 0x4593e01e, 0x4152fda9,
-    0x5f15adac, 0x5bd4b01b, 0x569796c2, 0x52568b75,
-    0x6a1936c8, 0x6ed82b7f, 0x639b0da6, 0x675a1011,
-    0x791d4014, 0x7ddc5da3, 0x709f7b7a, 0x745e66cd,
-    0x9823b6e0, 0x9ce2ab57, 0x91a18d8e, 0x95609039,
-    0x8b27c03c, 0x8fe6dd8b, 0x82a5fb52, 0x8664e6e5,
-    0xbe2b5b58, 0xbaea46ef, 0xb7a96036, 0xb3687d81,
-    0xad2f2d84, 0xa9ee3033, 0xa4ad16ea, 0xa06c0b5d,
-    0xd4326d90, 0xd0f37027, 0xddb056fe, 0xd9714b49,
-    0xc7361b4c, 0xc3f706fb, 0xceb42022, 0xca753d95,
-    0xf23a8028, 0xf6fb9d9f, 0xfbb8bb46, 0xff79a6f1,
-    0xe13ef6f4, 0xe5ffeb43, 0xe8bccd9a, 0xec7dd02d,
-    0x34867077, 0x30476dc0, 0x3d044b19, 0x39c556ae,
-    0x278206ab, 0x23431b1c, 0x2e003dc5, 0x2ac12072,
-    0x128e9dcf, 0x164f8078, 0x1b0ca6a1, 0x1fcdbb16,
-    0x018aeb13, 0x054bf6a4, 0x0808d07d, 0x0cc9cdca,
-    0x7897ab07, 0x7c56b6b0, 0x71159069, 0x75d48dde,
-    0x6b93dddb, 0x6f52c06c, 0x6211e6b5, 0x66d0fb02,
-    0x5e9f46bf, 0x5a5e5b08, 0x571d7dd1, 0x53dc6066,
-    0x4d9b3063, 0x495a2dd4, 0x44190b0d, 0x40d816ba,
-    0xaca5c697, 0xa864db20, 0xa527fdf9, 0xa1e6e04e,
-    0xbfa1b04b, 0xbb60adfc, 0xb6238b25, 0xb2e29692,
-    0x8aad2b2f, 0x8e6c3698, 0x832f1041, 0x87ee0df6,
-    0x99a95df3, 0x9d684044, 0x902b669d, 0x94ea7b2a,
-    0xe0b41de7, 0xe4750050, 0xe9362689, 0xedf73b3e,
-    0xf3b06b3b, 0xf771768c, 0xfa325055, 0xfef34de2,
-    0xc6bcf05f, 0xc27dede8, 0xcf3ecb31, 0xcbffd686,
-    0xd5b88683, 0xd1799b34, 0xdc3abded, 0xd8fba05a,
-    0x690ce0ee, 0x6dcdfd59, 0x608edb80, 0x644fc637,
-    0x7a089632, 0x7ec98b85, 0x738aad5c, 0x774bb0eb,
-    0x4f040d56, 0x4bc510e1, 0x46863638, 0x42472b8f,
-    0x5c007b8a, 0x58c1663d, 0x558240e4, 0x51435d53,
-    0x251d3b9e, 0x21dc2629, 0x2c9f00f0, 0x285e1d47,
-    0x36194d42, 0x32d850f5, 0x3f9b762c, 0x3b5a6b9b,
-    0x0315d626, 0x07d4cb91, 0x0a97ed48, 0x0e56f0ff,
-    0x1011a0fa, 0x14d0bd4d, 0x19939b94, 0x1d528623,
-    0xf12f560e, 0xf5ee4bb9, 0xf8ad6d60, 0xfc6c70d7,
-    0xe22b20d2, 0xe6ea3d65, 0xeba91bbc, 0xef68060b,
-    0xd727bbb6, 0xd3e6a601, 0xdea580d8, 0xda649d6f,
-    0xc423cd6a, 0xc0e2d0dd, 0xcda1f604, 0xc960ebb3,
-    0xbd3e8d7e, 0xb9ff90c9, 0xb4bcb610, 0xb07daba7,
-    0xae3afba2, 0xaafbe615, 0xa7b8c0cc, 0xa379dd7b,
-    0x9b3660c6, 0x9ff77d71, 0x92b45ba8, 0x9675461f,
-    0x8832161a, 0x8cf30bad, 0x81b02d74, 0x857130c3,
-    0x5d8a9099, 0x594b8d2e, 0x5408abf7, 0x50c9b640,
-    0x4e8ee645, 0x4a4ffbf2, 0x470cdd2b, 0x43cdc09c,
-    0x7b827d21, 0x7f436096, 0x7200464f, 0x76c15bf8,
-    0x68860bfd, 0x6c47164a, 0x61043093, 0x65c52d24,
-    0x119b4be9, 0x155a565e, 0x18197087, 0x1cd86d30,
-    0x029f3d35, 0x065e2082, 0x0b1d065b, 0x0fdc1bec,
-    0x3793a651, 0x3352bbe6, 0x3e119d3f, 0x3ad08088,
-    0x2497d08d, 0x2056cd3a, 0x2d15ebe3, 0x29d4f654,
-    0xc5a92679, 0xc1683bce, 0xcc2b1d17, 0xc8ea00a0,
-    0xd6ad50a5, 0xd26c4d12, 0xdf2f6bcb, 0xdbee767c,
-    0xe3a1cbc1, 0xe760d676, 0xea23f0af, 0xeee2ed18,
-    0xf0a5bd1d, 0xf464a0aa, 0xf9278673, 0xfde69bc4,
-    0x89b8fd09, 0x8d79e0be, 0x803ac667, 0x84fbdbd0,
-    0x9abc8bd5, 0x9e7d9662, 0x933eb0bb, 0x97ffad0c,
-    0xafb010b1, 0xab710d06, 0xa6322bdf, 0xa2f33668,
-    0xbcb4666d, 0xb8757bda, 0xb5365d03, 0xb1f740b4,
-};
+    u64 *secret = global_hash_wy_secret;
+    u64 a = 0;
+    u64 b = 0;
+    seed ^= HashMix(seed ^ secret[0], secret[1]);
+    if(size <= 16)
+    {
+        if(size >= 4)
+        {
+            u64 offset = (size >> 3) << 2;
+            a = (HashRead32(p) << 32) | HashRead32(p + offset);
+            b = (HashRead32(p + size - 4) << 32) | HashRead32(p + size - 4 - offset);
+        }
+        else if(size > 0)
+        {
+            a = ((u64)p[0] << 16) | ((u64)p[size >> 1] << 8) | p[size - 1];
+        }
+    }
+    else
+    {
+        u64 remaining = size;
+        if(remaining > 48)
+        {
+            u64 see1 = seed;
+            u64 see2 = seed;
+            do
+            {
+                seed = HashMix(HashRead64(p) ^ secret[1], HashRead64(p + 8) ^ seed);
+                see1 = HashMix(HashRead64(p + 16) ^ secret[2], HashRead64(p + 24) ^ see1);
+                see2 = HashMix(HashRead64(p + 32) ^ secret[3], HashRead64(p + 40) ^ see2);
+                p += 48;
+                remaining -= 48;
+            }
+            while(remaining > 48);
+            seed ^= see1 ^ see2;
+        }
+        while(remaining > 16)
+        {
+            seed = HashMix(HashRead64(p) ^ secret[1], HashRead64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        a = HashRead64(p + remaining - 16);
+        b = HashRead64(p + remaining - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+#if _MSC_VER
+    a = _umul128(a, b, &b);
+#else
+    unsigned __int128 product = (unsigned __int128)a * b;
+    a = (u64)product;
+    b = (u64)(product >> 64);
+#endif
+    return HashMix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
+
+// NOTE(rjf): One stripe: every lane adds its data, multiplied 32x32 with the
+// data xor the key's top half, and also adds the plain data to its neighbor
+// so no input bits are lost to the multiply.
+internal void
+HashAccumulateSSE2(__m128i *acc, u8 *data, u64 *key)
+{
+    for(u32 i = 0; i < 4; ++i)
+    {
+        __m128i d = _mm_loadu_si128((__m128i *)data + i);
+        __m128i k = _mm_loadu_si128((__m128i *)key + i);
+        __m128i dk = _mm_xor_si128(d, k);
+        __m128i product = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+        __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+        acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swapped));
+    }
+}
+
+internal void
+HashScrambleSSE2(__m128i *acc, u64 *key)
+{
+    __m128i prime = _mm_set1_epi32((int)0x9e3779b1);
+    for(u32 i = 0; i < 4; ++i)
+    {
+        __m128i a = acc[i];
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128((__m128i *)key + i));
+        __m128i low = _mm_mul_epu32(a, prime);
+        __m128i high = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+        acc[i] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+    }
+}
+
+internal void
+HashLongSSE2(u64 *lanes, u8 *p, u64 size, u64 *key)
+{
+    __m128i acc[4];
+    for(u32 i = 0; i < 4; ++i)
+    {
+        acc[i] = _mm_loadu_si128((__m128i *)lanes + i);
+    }
+    u64 stripe_count = (size - 1) / HASH_STRIPE_SIZE;
+    u64 block_count = stripe_count / HASH_STRIPES_PER_BLOCK;
+    for(u64 block = 0; block < block_count; ++block)
+    {
+        for(u64 stripe = 0; stripe < HASH_STRIPES_PER_BLOCK; ++stripe)
+        {
+            HashAccumulateSSE2(acc, p + stripe*HASH_STRIPE_SIZE, key + stripe);
+        }
+        HashScrambleSSE2(acc, key + HASH_STRIPES_PER_BLOCK);
+        p += HASH_STRIPES_PER_BLOCK*HASH_STRIPE_SIZE;
+        size -= HASH_STRIPES_PER_BLOCK*HASH_STRIPE_SIZE;
+    }
+    for(u64 stripe = 0; stripe < stripe_count % HASH_STRIPES_PER_BLOCK; ++stripe)
+    {
+        HashAccumulateSSE2(acc, p + stripe*HASH_STRIPE_SIZE, key + stripe);
+    }
+    HashAccumulateSSE2(acc, p + size - HASH_STRIPE_SIZE, key + HASH_STRIPES_PER_BLOCK - 1);
+    for(u32 i = 0; i < 4; ++i)
+    {
+        _mm_storeu_si128((__m128i *)lanes + i, acc[i]);
+    }
+}
+
+TARGET_AVX2 internal void
+HashAccumulateAVX2(__m256i *acc, u8 *data, u64 *key)
+{
+    for(u32 i = 0; i < 2; ++i)
+    {
+        __m256i d = _mm256_loadu_si256((__m256i *)data + i);
+        __m256i k = _mm256_loadu_si256((__m256i *)key + i);
+        __m256i dk = _mm256_xor_si256(d, k);
+        __m256i product = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+        __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+        acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(product, swapped));
+    }
+}
+
+TARGET_AVX2 internal void
+HashScrambleAVX2(__m256i *acc, u64 *key)
+{
+    __m256i prime = _mm256_set1_epi32((int)0x9e3779b1);
+    for(u32 i = 0; i < 2; ++i)
+    {
+        __m256i a = acc[i];
+        a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+        a = _mm256_xor_si256(a, _mm256_loadu_si256((__m256i *)key + i));
+        __m256i low = _mm256_mul_epu32(a, prime);
+        __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+        acc[i] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+    }
+}
+
+TARGET_AVX2 internal void
+HashLongAVX2(u64 *lanes, u8 *p, u64 size, u64 *key)
+{
+    __m256i acc[2];
+    acc[0] = _mm256_loadu_si256((__m256i *)lanes + 0);
+    acc[1] = _mm256_loadu_si256((__m256i *)lanes + 1);
+    u64 stripe_count = (size - 1) / HASH_STRIPE_SIZE;
+    u64 block_count = stripe_count / HASH_STRIPES_PER_BLOCK;
+    for(u64 block = 0; block < block_count; ++block)
+    {
+        for(u64 stripe = 0; stripe < HASH_STRIPES_PER_BLOCK; ++stripe)
+        {
+            HashAccumulateAVX2(acc, p + stripe*HASH_STRIPE_SIZE, key + stripe);
+        }
+        HashScrambleAVX2(acc, key + HASH_STRIPES_PER_BLOCK);
+        p += HASH_STRIPES_PER_BLOCK*HASH_STRIPE_SIZE;
+        size -= HASH_STRIPES_PER_BLOCK*HASH_STRIPE_SIZE;
+    }
+    for(u64 stripe = 0; stripe < stripe_count % HASH_STRIPES_PER_BLOCK; ++stripe)
+    {
+        HashAccumulateAVX2(acc, p + stripe*HASH_STRIPE_SIZE, key + stripe);
+    }
+    HashAccumulateAVX2(acc, p + size - HASH_STRIPE_SIZE, key + HASH_STRIPES_PER_BLOCK - 1);
+    _mm256_storeu_si256((__m256i *)lanes + 0, acc[0]);
+    _mm256_storeu_si256((__m256i *)lanes + 1, acc[1]);
+}
+
+internal u64
+HashLong(u8 *p, u64 size, u64 seed)
+{
+    // NOTE(rjf): The seed goes into the key, added to even words and taken
+    // from odd ones.
+    u64 key[24];
+    for(u32 i = 0; i < 24; ++i)
+    {
+        key[i] = (i & 1) ? global_hash_long_secret[i] - seed : global_hash_long_secret[i] + seed;
+    }
+    u64 lanes[8];
+    for(u32 i = 0; i < 8; ++i)
+    {
+        lanes[i] = global_hash_wy_secret[i & 3] ^ (u64)i;
+    }
+    if(CPUHas(AVX2))
+    {
+        HashLongAVX2(lanes, p, size, key);
+    }
+    else
+    {
+        HashLongSSE2(lanes, p, size, key);
+    }
+    u64 result = size * 0x9e3779b185ebca87ull;
+    for(u32 i = 0; i < 4; ++i)
+    {
+        result += HashMix(lanes[2*i] ^ key[2*i + 1], lanes[2*i + 1] ^ key[2*i + 2]);
+    }
+    return HashMix(result ^ global_hash_wy_secret[0], seed ^ global_hash_wy_secret[1]);
+}
+
+internal u64
+Hash64(void *data, u64 size, u64 seed)
+{
+    u64 result = 0;
+    if(size <= HASH_LONG_THRESHOLD)
+    {
+        result = HashShort((u8 *)data, size, seed);
+    }
+    else
+    {
+        result = HashLong((u8 *)data, size, seed);
+    }
+    return result;
+}
+
+internal u64
+StringHash64(String8 string, u64 seed)
+{
+    return Hash64(string.str, string.size, seed);
+}
 
+//~ NOTE(rjf): String Interning
+
+#define STRING_INTERN_SEED         0x9e3779b97f4a7c15ull
+#define STRING_INTERN_MIN_CAPACITY 1024
+
+internal StringInternSlots *
+StringInternSlotsAllocate(u64 capacity)
+{
+    u64 size = sizeof(StringInternSlots) + capacity*sizeof(u64);
+    StringInternSlots *slots = os->Reserve(size);
+    os->Commit(slots, size);
+    slots->mask = capacity - 1;
+    slots->slots = (u64 *)(slots + 1);
+    return slots;
+}
+
+internal StringInternTable
+StringInternTableInitialize(u32 max_count, u32 expected_count)
+{
+    StringInternTable table = {0};
+    table.seed = STRING_INTERN_SEED;
+    table.max_count = max_count;
+    table.id_count = 1;
+    table.entry_arena = M_ConcurrentArenaInitialize((u64)(max_count + 1)*sizeof(StringInternEntry), 0);
+    table.entries = table.entry_arena.base;
+    table.string_arena = M_ConcurrentArenaInitialize(Gigabytes(16), 0);
+    
+    u64 capacity = STRING_INTERN_MIN_CAPACITY;
+    while(capacity < 2*(u64)expected_count)
+    {
+        capacity *= 2;
+    }
+    table.slots = StringInternSlotsAllocate(capacity);
+    return table;
+}
+
+internal void
+StringInternTableRelease(StringInternTable *table)
+{
+    for(StringInternSlots *slots = table->slots, *previous = 0; slots; slots = previous)
+    {
+        previous = slots->previous;
+        os->Release(slots);
+    }
+    M_ConcurrentArenaRelease(&table->entry_arena);
+    M_ConcurrentArenaRelease(&table->string_arena);
+    MemorySet(table, 0, sizeof(*table));
+}
+
+internal b32
+StringInternEntryMatch(StringInternEntry *entry, u64 hash, String8 string)
+{
+    return entry->hash == hash && StringMatch(entry->string, string);
+}
+
+// NOTE(rjf): Never blocks, and may run during a grow. A string interned by
+// another thread at the same moment may or may not be seen.
 internal u32
-CStringCRC32N(char *name, u32 n)
+StringInternLookupHashed(StringInternTable *table, String8 string, u64 hash)
 {
-    u32 crc = 0;
-    for(u32 i = 0; name[i] && i < n; ++i)
+    u32 result = 0;
+    u64 tag = hash >> 32;
+    StringInternSlots *slots = (StringInternSlots *)AtomicLoadU64(&table->slots);
+    for(u64 i = hash & slots->mask;; i = (i + 1) & slots->mask)
     {
-        crc = (crc << 8) ^ global_crc32_table[((crc >> 24) ^ name[i]) & 255];
+        u64 slot = AtomicLoadU64(&slots->slots[i]);
+        if(slot == 0)
+        {
+            break;
+        }
+        if((slot >> 32) == tag && StringInternEntryMatch(&table->entries[(u32)slot], hash, string))
+        {
+            result = (u32)slot;
+            break;
+        }
     }
-    return crc;
+    return result;
 }
 
 internal u32
-CStringCRC32(char *name)
+StringInternLookup(StringInternTable *table, String8 string)
 {
-    return CStringCRC32N(name, (u32)(u32)(-1));
+    return StringInternLookupHashed(table, string, StringHash64(string, table->seed));
+}
+
+// NOTE(rjf): Called once a writer sees the array past half full. Only one
+// thread rebuilds; everyone else carries on, and writers wait for it at
+// their next intern.
+internal void
+StringInternGrow(StringInternTable *table, StringInternSlots *old_slots)
+{
+    if(AtomicCompareExchangeU32(&table->growing, 1, 0) == 0)
+    {
+        if(table->slots == old_slots)
+        {
+            while(AtomicLoadU32(&table->active_writers) != 0)
+            {
+                SpinPause();
+            }
+            
+            StringInternSlots *new_slots = StringInternSlotsAllocate(2*(old_slots->mask + 1));
+            for(u64 old_index = 0; old_index <= old_slots->mask; ++old_index)
+            {
+                u64 slot = old_slots->slots[old_index];
+                if(slot)
+                {
+                    u64 i = table->entries[(u32)slot].hash & new_slots->mask;
+                    while(new_slots->slots[i])
+                    {
+                        i = (i + 1) & new_slots->mask;
+                    }
+                    new_slots->slots[i] = slot;
+                }
+            }
+            new_slots->count = old_slots->count;
+            new_slots->previous = old_slots;
+            AtomicStoreU64(&table->slots, (u64)new_slots);
+        }
+        AtomicStoreU32(&table->growing, 0);
+    }
+}
+
+// NOTE(rjf): Returns the string's id, interning a copy of it first if it
+// isn't in the table yet. Returns 0 once max_count strings are interned.
+internal u32
+StringIntern(StringInternTable *table, StringInternCursor *cursor, String8 string)
+{
+    u64 hash = StringHash64(string, table->seed);
+    u32 result = StringInternLookupHashed(table, string, hash);
+    if(result == 0)
+    {
+        u64 tag = hash >> 32;
+        u32 new_id = 0;
+        b32 inserted = 0;
+        StringInternSlots *slots = 0;
+        
+        // NOTE(rjf): Register as a writer, then check for a grow in
+        // progress; the grower sets its flag, then waits for writers, so
+        // one of the two always sees the other.
+        for(;;)
+        {
+            AtomicAddU32(&table->active_writers, 1);
+            if(!AtomicLoadU32(&table->growing))
+            {
+                break;
+            }
+            AtomicAddU32(&table->active_writers, (u32)-1);
+            while(AtomicLoadU32(&table->growing))
+            {
+                SpinPause();
+            }
+        }
+        
+        slots = (StringInternSlots *)AtomicLoadU64(&table->slots);
+        for(u64 i = hash & slots->mask;; i = (i + 1) & slots->mask)
+        {
+            u64 slot = AtomicLoadU64(&slots->slots[i]);
+            if(slot == 0)
+            {
+                // NOTE(rjf): Fill in the entry before publishing its id, so
+                // anyone who sees the slot sees the string too.
+                if(new_id == 0)
+                {
+                    new_id = cursor->spare_id;
+                    cursor->spare_id = 0;
+                    if(new_id == 0)
+                    {
+                        new_id = AtomicAddU32(&table->id_count, 1);
+                        if(new_id > table->max_count ||
+                           !M_ConcurrentArenaEnsureCommitted(&table->entry_arena,
+                                                             (u64)(new_id + 1)*sizeof(StringInternEntry)))
+                        {
+                            new_id = 0;
+                            break;
+                        }
+                    }
+                    u8 *copy = M_ConcurrentArenaPushAligned(&table->string_arena, &cursor->string_cursor,
+                                                            string.size + 1, 1);
+                    MemoryCopy(copy, string.str, string.size);
+                    copy[string.size] = 0;
+                    table->entries[new_id].hash = hash;
+                    table->entries[new_id].string = S8(copy, string.size);
+                }
+                
+                u64 new_slot = (tag << 32) | new_id;
+                slot = AtomicCompareExchangeU64(&slots->slots[i], new_slot, 0);
+                if(slot == 0)
+                {
+                    result = new_id;
+                    inserted = 1;
+                    AtomicAddU64(&slots->count, 1);
+                    break;
+                }
+            }
+            if((slot >> 32) == tag && StringInternEntryMatch(&table->entries[(u32)slot], hash, string))
+            {
+                result = (u32)slot;
+                break;
+            }
+        }
+        
+        AtomicAddU32(&table->active_writers, (u32)-1);
+        
+        if(inserted)
+        {
+            if(2*AtomicLoadU64(&slots->count) > slots->mask + 1)
+            {
+                StringInternGrow(table, slots);
+            }
+        }
+        else if(new_id != 0)
+        {
+            // NOTE(rjf): Another thread interned the same string first. Keep
+            // the id for next time, and hand back the copy if nothing has
+            // been pushed after it.
+            cursor->spare_id = new_id;
+            M_ConcurrentArenaCursor *string_cursor = &cursor->string_cursor;
+            u8 *copy_end = table->entries[new_id].string.str + string.size + 1;
+            if((u8 *)table->string_arena.base + string_cursor->position == copy_end)
+            {
+                string_cursor->position -= string.size + 1;
+            }
+            table->entries[new_id].hash = 0;
+            table->entries[new_id].string = S8(0, 0);
+        }
+    }
+    return result;
+}
+
+// NOTE(rjf): Only ids returned by StringIntern name a string. Any other id
+// gives an empty string: ids past max_count were never backed by an entry,
+// and a spare id held back by a cursor has its entry cleared.
+internal String8
+StringFromInternID(StringInternTable *table, u32 id)
+{
+    String8 result = {0};
+    if(id != 0 && id <= table->max_count && id < AtomicLoadU32(&table->id_count))
+    {
+        result = table->entries[id].string;
+    }
+    return result;
 }
 
 internal void
@@ -78,13 +78,263 @@ struct String8
     u64 size;
 };
 
+internal String8
+S8(u8 *str, u64 size)
+{
+    String8 string;
+    string.str = str;
+    string.size = size;
+    return string;
+}
+
+typedef struct String16 String16;
+struct String16
+{
+    u16 *str;
+    u64 size;
+};
+
+typedef struct String32 String32;
+struct String32
+{
+    u32 *str;
+    u64 size;
+};
+
+typedef struct UnicodeDecode UnicodeDecode;
+struct UnicodeDecode
+{
+    u32 codepoint;
+    u32 advance;
+};
+
 #define S8Lit(s) S8((u8*)(s), ArrayCount(s) - 1)
 #define S8LitComp(s) {(u8*)(s), ArrayCount(s) - 1}
 #define StringExpand(s) (int)((s).size), ((s).str)
 
+// NOTE(rjf): Singly-linked list of strings. Nodes point at their strings
+// rather than owning them, so pushing and concatenating never copy string
+// data; total_size is kept up to date so a join can size its output up
+// front.
+typedef struct String8Node String8Node;
+struct String8Node
+{
+    String8Node *next;
+    String8 string;
+};
+
+typedef struct String8List String8List;
+struct String8List
+{
+    String8Node *first;
+    String8Node *last;
+    u64 node_count;
+    u64 total_size;
+};
+
+// NOTE(rjf): Open-addressed table of interned strings. Each slot is
+// (hash tag << 32) | id, and is claimed with a single compare-exchange, so
+// threads intern concurrently without a lock. Ids are dense, start at 1 (0
+// means "not interned"), and never change; the strings behind them live in
+// a concurrent arena until the table is released.
+//
+// Growing rebuilds the slots into a new array twice the size and swaps the
+// pointer. Readers keep probing whichever array they loaded, so they never
+// wait; writers pause while a rebuild is running. Old arrays are kept until
+// release, since a reader may still be in one.
+typedef struct StringInternSlots StringInternSlots;
+struct StringInternSlots
+{
+    StringInternSlots *previous;
+    u64 mask;
+    volatile u64 count;
+    u64 *slots;
+};
+
+typedef struct StringInternEntry StringInternEntry;
+struct StringInternEntry
+{
+    u64 hash;
+    String8 string;
+};
+
+typedef struct StringInternTable StringInternTable;
+struct StringInternTable
+{
+    StringInternSlots *volatile slots;
+    u64 seed;
+    u32 max_count;
+    volatile u32 id_count;
+    volatile u32 active_writers;
+    volatile u32 growing;
+    StringInternEntry *entries;
+    M_ConcurrentArena entry_arena;
+    M_ConcurrentArena string_arena;
+};
+
+// NOTE(rjf): One per interning thread. spare_id holds an id the thread
+// allocated but lost a race with, so it's used for the thread's next new
+// string instead of leaving a hole.
+typedef struct StringInternCursor StringInternCursor;
+struct StringInternCursor
+{
+    M_ConcurrentArenaCursor string_cursor;
+    u32 spare_id;
+};
+
+// NOTE(rjf): Byte set for delimiter scanning. The nibble tables let AVX2
+// test 32 bytes against any set of ASCII bytes with two shuffles: a byte b
+// is in the set when low_nibble_masks[b & 15] & high_nibble_bits[b >> 4]
+// is nonzero. Sets of up to 8 bytes also keep the bytes themselves for the
+// SSE2 path; the bitmap covers everything else.
+typedef struct StringCharSet StringCharSet;
+struct StringCharSet
+{
+    u8 low_nibble_masks[16];
+    u8 high_nibble_bits[16];
+    u8 bitmap[32];
+    u8 chars[8];
+    u32 char_count;
+    b32 has_non_ascii;
+};
+
+typedef u32 StringSplitFlags;
+enum
+{
+    // NOTE(rjf): Runs of delimiters count as one, and there are no empty
+    // pieces at the ends.
+    StringSplitFlag_SkipEmpty = (1<<0),
+};
+
+typedef struct StringSplitIterator StringSplitIterator;
+struct StringSplitIterator
+{
+    String8 string;
+    u64 position;
+    StringCharSet *delimiters;
+    StringSplitFlags flags;
+    b32 done;
+};
+
+typedef struct StringLineIterator StringLineIterator;
+struct StringLineIterator
+{
+    String8 string;
+    u64 position;
+};
+
+typedef enum StringTokenKind
+{
+    StringTokenKind_Null,
+    StringTokenKind_Identifier,
+    StringTokenKind_Number,
+    StringTokenKind_String,
+    StringTokenKind_Symbol,
+    StringTokenKind_Other,
+}
+StringTokenKind;
+
+typedef struct StringToken StringToken;
+struct StringToken
+{
+    StringTokenKind kind;
+    u64 offset;
+    String8 string;
+};
+
+typedef struct StringTokenizer StringTokenizer;
+struct StringTokenizer
+{
+    String8 string;
+    u64 position;
+};
+
+// NOTE(rjf): line_starts holds line_count + 1 offsets; line i is
+// [line_starts[i], line_starts[i + 1]) less its line ending.
+typedef struct StringLineIndex StringLineIndex;
+struct StringLineIndex
+{
+    u64 *line_starts;
+    u64 line_count;
+};
+
+#define STRING_FUZZY_QUERY_MAX 256
+
+typedef struct StringFuzzyMatch StringFuzzyMatch;
+struct StringFuzzyMatch
+{
+    u32 index;
+    i32 score;
+};
+
+// NOTE(rjf): Candidates matching one query, in candidate order. Level 0 is
+// the empty query and has no matches array; every candidate is in it.
+typedef struct StringFuzzyLevel StringFuzzyLevel;
+struct StringFuzzyLevel
+{
+    u64 query_size;
+    u64 arena_position;
+    StringFuzzyMatch *matches;
+    u32 match_count;
+};
+
+// NOTE(rjf): Matches queries as case-insensitive subsequences of the
+// candidates. Each candidate gets a 32-bit mask of the characters it has
+// (StringFuzzyCharMask), and a candidate whose mask is missing any of the
+// query's bits is skipped before scoring. Levels form a stack, one for each
+// query the current one extends: typing a character only rescans the
+// matches of the previous query, and deleting one pops back to the
+// matches that are already computed.
+typedef struct StringFuzzyMatcher StringFuzzyMatcher;
+struct StringFuzzyMatcher
+{
+    String8 *candidates;
+    u32 candidate_count;
+    u32 *char_masks;
+    u8 query[STRING_FUZZY_QUERY_MAX];
+    u64 query_size;
+    u32 level_count;
+    StringFuzzyLevel levels[STRING_FUZZY_QUERY_MAX + 1];
+    M_Arena arena;
+};
+
+typedef u32 FormatFlags;
+enum
+{
+    FormatFlag_LeftJustify = (1<<0),
+    FormatFlag_ZeroPad     = (1<<1),
+    FormatFlag_Plus        = (1<<2),
+    FormatFlag_Space       = (1<<3),
+    FormatFlag_Alternate   = (1<<4),
+    FormatFlag_Uppercase   = (1<<5),
+};
+
+// NOTE(rjf): One parsed printf conversion. precision is -1 when not given.
+typedef struct FormatSpec FormatSpec;
+struct FormatSpec
+{
+    FormatFlags flags;
+    i32 width;
+    i32 precision;
+    u8 length[2];
+    u8 conversion;
+};
+
+// NOTE(rjf): Output cursor over an arena's free tail. Bytes are written
+// past alloc_position, up to what's committed (less one byte for the NUL),
+// and only pushed once the whole string is done.
+typedef struct FormatWriter FormatWriter;
+struct FormatWriter
+{
+    M_Arena *arena;
+    u8 *str;
+    u64 size;
+    u64 capacity;
+};
+
 typedef u32 StringMatchFlags;
 enum
 {
-    StringMatchFlag_MatchCase       = (1<<0),
+    StringMatchFlag_CaseInsensitive = (1<<0),
     StringMatchFlag_RightSideSloppy = (1<<1),
 };
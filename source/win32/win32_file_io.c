@@ -1,16 +1,84 @@
 
-internal char *
-W32_FrameCStringFromString(String8 string)
+// NOTE(rjf): Paths are UTF-8 String8s on our side and go through the W entry
+// points, so names outside the ANSI code page work.
+internal WCHAR *
+W32_WideFromString(M_Arena *arena, String8 string)
+{
+    return (WCHAR *)String16FromString8(arena, string).str;
+}
+
+// NOTE(rjf): Writes the list's nodes in order without joining them first.
+// Big nodes go straight to WriteFile; runs of small ones are batched into a
+// staging buffer so a list of many short strings isn't one call per node.
+// (WriteFileGather only takes page-sized, page-aligned buffers on
+// unbuffered handles, so it can't be used for arbitrary strings.)
+#define W32_GATHER_STAGING_SIZE Kilobytes(64)
+#define W32_GATHER_DIRECT_SIZE  Kilobytes(4)
+
+internal b32
+W32_WriteFileFull(HANDLE file, void *data, u64 data_len)
+{
+    b32 success = 1;
+    u64 total_bytes_written = 0;
+    while(success && total_bytes_written < data_len)
+    {
+        // NOTE(rjf): WriteFile takes a DWORD size, so big writes go in
+        // pieces.
+        DWORD bytes_to_write = (DWORD)Min(data_len - total_bytes_written, (u64)Gigabytes(1));
+        DWORD bytes_written = 0;
+        success = (WriteFile(file, (u8 *)data + total_bytes_written, bytes_to_write, &bytes_written, 0) &&
+                   bytes_written == bytes_to_write);
+        total_bytes_written += bytes_written;
+    }
+    return success;
+}
+
+internal b32
+W32_WriteList(HANDLE file, String8List *list)
 {
-    char *buffer = 0;
-    buffer = M_ArenaPushZero(&os->frame_arena, string.size+1);
-    MemoryCopy(buffer, string.str, string.size);
-    return buffer;
+    M_Temp scratch = M_GetScratch(0, 0);
+    u8 *staging = 0;
+    u64 staged_size = 0;
+    b32 success = 1;
+    
+    for(String8Node *node = list->first; success && node; node = node->next)
+    {
+        String8 string = node->string;
+        if(staged_size && (string.size >= W32_GATHER_DIRECT_SIZE ||
+                           staged_size + string.size > W32_GATHER_STAGING_SIZE))
+        {
+            success = W32_WriteFileFull(file, staging, staged_size);
+            staged_size = 0;
+        }
+        if(string.size >= W32_GATHER_DIRECT_SIZE)
+        {
+            success = success && W32_WriteFileFull(file, string.str, string.size);
+        }
+        else
+        {
+            if(!staging)
+            {
+                staging = M_ArenaPush(scratch.arena, W32_GATHER_STAGING_SIZE);
+            }
+            MemoryCopy(staging + staged_size, string.str, string.size);
+            staged_size += string.size;
+        }
+    }
+    if(success && staged_size)
+    {
+        success = W32_WriteFileFull(file, staging, staged_size);
+    }
+    
+    M_ReleaseScratch(scratch);
+    return success;
 }
 
 internal void
-W32_SaveToFile(String8 path, void *data, u64 data_len)
+W32_SaveListToFile(String8 path, String8List *list)
 {
+    M_Temp scratch = M_GetScratch(0, 0);
+    WCHAR *wide_path = W32_WideFromString(scratch.arena, path);
+    
     HANDLE file = {0};
     {
         DWORD desired_access = GENERIC_READ | GENERIC_WRITE;
@@ -24,33 +92,32 @@ W32_SaveToFile(String8 path, void *data, u64 data_len)
         DWORD flags_and_attributes = 0;
         HANDLE template_file = 0;
         
-        if((file = CreateFile(W32_FrameCStringFromString(path),
-                              desired_access,
-                              share_mode,
-                              &security_attributes,
-                              creation_disposition,
-                              flags_and_attributes,
-                              template_file)) != INVALID_HANDLE_VALUE)
+        if((file = CreateFileW(wide_path,
+                               desired_access,
+                               share_mode,
+                               &security_attributes,
+                               creation_disposition,
+                               flags_and_attributes,
+                               template_file)) != INVALID_HANDLE_VALUE)
         {
-            
-            void *data_to_write = data;
-            DWORD data_to_write_size = (DWORD)data_len;
-            DWORD bytes_written = 0;
-            
-            WriteFile(file, data_to_write, data_to_write_size, &bytes_written, 0);
-            
+            W32_WriteList(file, list);
             CloseHandle(file);
         }
         else
         {
-            W32_OutputError("File I/O Error", "Could not save to \"%s\"", path);
+            W32_OutputError("File I/O Error", "Could not save to \"%.*s\"", StringExpand(path));
         }
     }
+    
+    M_ReleaseScratch(scratch);
 }
 
 internal void
-W32_AppendToFile(String8 path, void *data, u64 data_len)
+W32_AppendListToFile(String8 path, String8List *list)
 {
+    M_Temp scratch = M_GetScratch(0, 0);
+    WCHAR *wide_path = W32_WideFromString(scratch.arena, path);
+    
     HANDLE file = {0};
     {
         DWORD desired_access = FILE_APPEND_DATA;
@@ -64,7 +131,7 @@ W32_AppendToFile(String8 path, void *data, u64 data_len)
         DWORD flags_and_attributes = 0;
         HANDLE template_file = 0;
         
-        if((file = CreateFileA(W32_FrameCStringFromString(path),
+        if((file = CreateFileW(wide_path,
                                desired_access,
                                share_mode,
                                &security_attributes,
@@ -72,26 +139,83 @@ W32_AppendToFile(String8 path, void *data, u64 data_len)
                                flags_and_attributes,
                                template_file)) != INVALID_HANDLE_VALUE)
         {
-            
-            void *data_to_write = data;
-            DWORD data_to_write_size = (DWORD)data_len;
-            DWORD bytes_written = 0;
-            
             SetFilePointer(file, 0, 0, FILE_END);
-            WriteFile(file, data_to_write, data_to_write_size, &bytes_written, 0);
-            
+            W32_WriteList(file, list);
             CloseHandle(file);
         }
         else
         {
-            W32_OutputError("File I/O Error", "Could not save to \"%s\"", path);
+            W32_OutputError("File I/O Error", "Could not save to \"%.*s\"", StringExpand(path));
+        }
+    }
+    
+    M_ReleaseScratch(scratch);
+}
+
+internal void
+W32_SaveToFile(String8 path, void *data, u64 data_len)
+{
+    String8Node node = {0};
+    String8List list = {0};
+    node.string = S8(data, data_len);
+    String8ListPushNode(&list, &node);
+    W32_SaveListToFile(path, &list);
+}
+
+internal void
+W32_AppendToFile(String8 path, void *data, u64 data_len)
+{
+    String8Node node = {0};
+    String8List list = {0};
+    node.string = S8(data, data_len);
+    String8ListPushNode(&list, &node);
+    W32_AppendListToFile(path, &list);
+}
+
+// NOTE(rjf): Reads up to data_len bytes starting at offset straight into
+// data; returns how many bytes were read.
+internal u64
+W32_ReadFromFile(String8 path, u64 offset, void *data, u64 data_len)
+{
+    M_Temp scratch = M_GetScratch(0, 0);
+    WCHAR *wide_path = W32_WideFromString(scratch.arena, path);
+    u64 total_bytes_read = 0;
+    
+    HANDLE file = CreateFileW(wide_path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, 0);
+    if(file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_offset;
+        file_offset.QuadPart = (LONGLONG)offset;
+        if(SetFilePointerEx(file, file_offset, 0, FILE_BEGIN))
+        {
+            // NOTE(rjf): ReadFile takes a DWORD size, so big reads go in
+            // pieces.
+            while(total_bytes_read < data_len)
+            {
+                DWORD bytes_to_read = (DWORD)Min(data_len - total_bytes_read, (u64)Gigabytes(1));
+                DWORD bytes_read = 0;
+                if(!ReadFile(file, (u8 *)data + total_bytes_read, bytes_to_read, &bytes_read, 0) ||
+                   bytes_read == 0)
+                {
+                    break;
+                }
+                total_bytes_read += bytes_read;
+            }
         }
+        CloseHandle(file);
     }
+    
+    M_ReleaseScratch(scratch);
+    return total_bytes_read;
 }
 
 internal void
 W32_LoadEntireFile(M_Arena *arena, String8 path, void **data, u64 *data_len)
 {
+    M_Temp scratch = M_GetScratch(&arena, 1);
+    WCHAR *wide_path = W32_WideFromString(scratch.arena, path);
+    
     *data = 0;
     *data_len = 0;
     
@@ -109,7 +233,7 @@ W32_LoadEntireFile(M_Arena *arena, String8 path, void **data, u64 *data_len)
         DWORD flags_and_attributes = 0;
         HANDLE template_file = 0;
         
-        if((file = CreateFile(W32_FrameCStringFromString(path), desired_access, share_mode, &security_attributes, creation_disposition, flags_and_attributes, template_file)) != INVALID_HANDLE_VALUE)
+        if((file = CreateFileW(wide_path, desired_access, share_mode, &security_attributes, creation_disposition, flags_and_attributes, template_file)) != INVALID_HANDLE_VALUE)
         {
             
             DWORD read_bytes = GetFileSize(file, 0);
@@ -129,11 +253,16 @@ W32_LoadEntireFile(M_Arena *arena, String8 path, void **data, u64 *data_len)
             CloseHandle(file);
         }
     }
+    
+    M_ReleaseScratch(scratch);
 }
 
 internal char *
 W32_LoadEntireFileAndNullTerminate(M_Arena *arena, String8 path)
 {
+    M_Temp scratch = M_GetScratch(&arena, 1);
+    WCHAR *wide_path = W32_WideFromString(scratch.arena, path);
+    
     char *result = 0;
     
     HANDLE file = {0};
@@ -149,7 +278,7 @@ W32_LoadEntireFileAndNullTerminate(M_Arena *arena, String8 path)
         DWORD flags_and_attributes = 0;
         HANDLE template_file = 0;
         
-        if((file = CreateFile(W32_FrameCStringFromString(path), desired_access, share_mode, &security_attributes, creation_disposition, flags_and_attributes, template_file)) != INVALID_HANDLE_VALUE)
+        if((file = CreateFileW(wide_path, desired_access, share_mode, &security_attributes, creation_disposition, flags_and_attributes, template_file)) != INVALID_HANDLE_VALUE)
         {
             
             DWORD read_bytes = GetFileSize(file, 0);
@@ -167,10 +296,11 @@ W32_LoadEntireFileAndNullTerminate(M_Arena *arena, String8 path)
         }
         else
         {
-            W32_OutputError("File I/O Error", "Could not read from \"%s\"", path);
+            W32_OutputError("File I/O Error", "Could not read from \"%.*s\"", StringExpand(path));
         }
     }
     
+    M_ReleaseScratch(scratch);
     return result;
 }
 
@@ -183,41 +313,51 @@ W32_FreeFileMemory(void *data)
 internal void
 W32_DeleteFile(String8 path)
 {
-    DeleteFileA(W32_FrameCStringFromString(path));
+    M_Temp scratch = M_GetScratch(0, 0);
+    DeleteFileW(W32_WideFromString(scratch.arena, path));
+    M_ReleaseScratch(scratch);
 }
 
 internal b32
 W32_MakeDirectory(String8 path)
 {
+    M_Temp scratch = M_GetScratch(0, 0);
     b32 result = 1;
-    if(!CreateDirectoryA(W32_FrameCStringFromString(path), 0))
+    if(!CreateDirectoryW(W32_WideFromString(scratch.arena, path), 0))
     {
         result = 0;
     }
+    M_ReleaseScratch(scratch);
     return result;
 }
 
 internal b32
 W32_DoesFileExist(String8 path)
 {
-    b32 found = GetFileAttributesA(W32_FrameCStringFromString(path)) != INVALID_FILE_ATTRIBUTES;
+    M_Temp scratch = M_GetScratch(0, 0);
+    b32 found = GetFileAttributesW(W32_WideFromString(scratch.arena, path)) != INVALID_FILE_ATTRIBUTES;
+    M_ReleaseScratch(scratch);
     return found;
 }
 
 internal b32
 W32_DoesDirectoryExist(String8 path)
 {
-    DWORD file_attributes = GetFileAttributesA(W32_FrameCStringFromString(path));
+    M_Temp scratch = M_GetScratch(0, 0);
+    DWORD file_attributes = GetFileAttributesW(W32_WideFromString(scratch.arena, path));
     b32 found = (file_attributes != INVALID_FILE_ATTRIBUTES &&
                  !!(file_attributes & FILE_ATTRIBUTE_DIRECTORY));
+    M_ReleaseScratch(scratch);
     return found;
 }
 
 internal b32
 W32_CopyFile(String8 dest, String8 source)
 {
+    M_Temp scratch = M_GetScratch(0, 0);
     b32 success = 0;
-    success = CopyFile(W32_FrameCStringFromString(source), W32_FrameCStringFromString(dest), 0);
+    success = CopyFileW(W32_WideFromString(scratch.arena, source), W32_WideFromString(scratch.arena, dest), 0);
+    M_ReleaseScratch(scratch);
     return success;
 }
 
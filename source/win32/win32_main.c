@@ -34,6 +34,7 @@ global char global_executable_directory[256];
 global char global_working_directory[256];
 global char global_app_dll_path[256];
 global char global_temp_app_dll_path[256];
+global char global_snapshot_path[256];
 global OS_State global_os;
 global HDC global_device_context;
 global HINSTANCE global_instance_handle;
@@ -198,7 +199,7 @@ W32_WindowProc(HWND window_handle, UINT message, WPARAM w_param, LPARAM l_param)
         }
         else
         {
-            result = DefWindowProc(window_handle, message, w_param, l_param);
+            result = DefWindowProcW(window_handle, message, w_param, l_param);
         }
     }
     else if(message == WM_SYSKEYDOWN || message == WM_SYSKEYUP ||
@@ -340,11 +341,29 @@ W32_WindowProc(HWND window_handle, UINT message, WPARAM w_param, LPARAM l_param)
             OS_PushEvent(OS_KeyReleaseEvent(key_input, modifiers));
         }
         
-        result = DefWindowProc(window_handle, message, w_param, l_param);
+        result = DefWindowProcW(window_handle, message, w_param, l_param);
     }
     else if(message == WM_CHAR)
     {
-        u64 char_input = w_param;
+        // NOTE(rjf): WM_CHAR carries UTF-16 code units; characters outside
+        // the BMP arrive as two messages, a high then a low surrogate, and
+        // are combined so the event always holds a whole code point.
+        local_persist u16 high_surrogate = 0;
+        u16 code_units[2] = { high_surrogate, (u16)w_param };
+        u64 char_input = 0;
+        high_surrogate = 0;
+        if(code_units[1] >= 0xd800 && code_units[1] <= 0xdbff)
+        {
+            high_surrogate = code_units[1];
+        }
+        else if(code_units[0] && code_units[1] >= 0xdc00 && code_units[1] <= 0xdfff)
+        {
+            char_input = UTF16DecodeCodepoint(code_units, 2).codepoint;
+        }
+        else
+        {
+            char_input = UTF16DecodeCodepoint(code_units + 1, 1).codepoint;
+        }
         if(char_input >= 32 && char_input != VK_RETURN && char_input != VK_ESCAPE &&
            char_input != 127)
         {
@@ -353,7 +372,7 @@ W32_WindowProc(HWND window_handle, UINT message, WPARAM w_param, LPARAM l_param)
     }
     else
     {
-        result = DefWindowProc(window_handle, message, w_param, l_param);
+        result = DefWindowProcW(window_handle, message, w_param, l_param);
     }
     
     return result;
@@ -425,32 +444,35 @@ WinMain(HINSTANCE instance, HINSTANCE prev_instance, LPSTR lp_cmd_line, int n_sh
         {
             wsprintf(global_app_dll_path, "%s%s.dll", global_executable_directory, PROGRAM_FILENAME);
             wsprintf(global_temp_app_dll_path, "%stemp_%s.dll", global_executable_directory, PROGRAM_FILENAME);
+            wsprintf(global_snapshot_path, "%s%s.snapshot", global_executable_directory, PROGRAM_FILENAME);
         }
         
         GetCurrentDirectory(sizeof(global_working_directory), global_working_directory);
     }
     
-    WNDCLASS window_class = {0};
+    // NOTE(rjf): The window class is registered as Unicode, so WM_CHAR
+    // delivers UTF-16 rather than the ANSI code page.
+    WNDCLASSW window_class = {0};
     {
         window_class.style = CS_HREDRAW | CS_VREDRAW;
         window_class.lpfnWndProc = W32_WindowProc;
         window_class.hInstance = instance;
-        window_class.lpszClassName = "ApplicationWindowClass";
+        window_class.lpszClassName = L"ApplicationWindowClass";
         window_class.hCursor = LoadCursor(0, IDC_ARROW);
     }
     
-    if(!RegisterClass(&window_class))
+    if(!RegisterClassW(&window_class))
     {
         // NOTE(rjf): ERROR: Window class registration failure
         W32_OutputError("Fatal Error", "Window class registration failure.");
         goto quit;
     }
     
-    HWND window_handle = CreateWindow("ApplicationWindowClass", WINDOW_TITLE,
-                                      WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT,
-                                      DEFAULT_WINDOW_WIDTH,
-                                      DEFAULT_WINDOW_HEIGHT,
-                                      0, 0, instance, 0);
+    HWND window_handle = CreateWindowW(L"ApplicationWindowClass", L"" WINDOW_TITLE,
+                                       WS_OVERLAPPEDWINDOW, CW_USEDEFAULT, CW_USEDEFAULT,
+                                       DEFAULT_WINDOW_WIDTH,
+                                       DEFAULT_WINDOW_HEIGHT,
+                                       0, 0, instance, 0);
     
     if(!window_handle)
     {
@@ -512,9 +534,16 @@ WinMain(HINSTANCE instance, HINSTANCE prev_instance, LPSTR lp_cmd_line, int n_sh
         global_os.Release                        = W32_Release;
         global_os.Commit                         = W32_Commit;
         global_os.Decommit                       = W32_Decommit;
+        global_os.ReserveLargePages              = W32_ReserveLargePages;
+        global_os.ReserveAt                      = W32_ReserveAt;
+        global_os.ReserveRing                    = W32_ReserveRing;
+        global_os.ReleaseRing                    = W32_ReleaseRing;
         global_os.OutputError                    = W32_OutputError;
         global_os.SaveToFile                     = W32_SaveToFile;
         global_os.AppendToFile                   = W32_AppendToFile;
+        global_os.SaveListToFile                 = W32_SaveListToFile;
+        global_os.AppendListToFile               = W32_AppendListToFile;
+        global_os.ReadFromFile                   = W32_ReadFromFile;
         global_os.LoadEntireFile                 = W32_LoadEntireFile;
         global_os.LoadEntireFileAndNullTerminate = W32_LoadEntireFileAndNullTerminate;
         global_os.DeleteFile                     = W32_DeleteFile;
@@ -531,8 +560,34 @@ WinMain(HINSTANCE instance, HINSTANCE prev_instance, LPSTR lp_cmd_line, int n_sh
         global_os.LoadOpenGLProcedure            = W32_LoadOpenGLProcedure;
         global_os.RefreshScreen                  = W32_OpenGLRefreshScreen;
         
+        global_os.large_page_size = W32_EnableLargePages();
+        
         global_os.permanent_arena = M_ArenaInitialize();
-        global_os.frame_arena = M_ArenaInitialize();
+        
+        // NOTE(rjf): The frame arena is refilled from zero every frame, so
+        // commit in bigger, geometrically growing steps to keep commit calls
+        // off the per-frame path.
+        {
+            M_ArenaParams params = M_ArenaDefaultParams();
+            params.commit_chunk_size = Megabytes(1);
+            params.commit_growth = 2.f;
+            global_os.frame_arena = M_ArenaInitializeWithParams(&params);
+        }
+        
+        M_ArenaSetName(&global_os.permanent_arena, "permanent");
+        M_ArenaSetName(&global_os.frame_arena, "frame");
+        M_ArenaPoolInitialize(&global_os.arena_pool);
+        global_os.heap = M_HeapInitialize(Gigabytes(64));
+        
+#if PERMANENT_ARENA_SNAPSHOT
+        {
+            M_ArenaSnapshotLoad snapshot = M_ArenaLoadSnapshot(&global_os.permanent_arena,
+                                                               String8FromCString(global_snapshot_path),
+                                                               PERMANENT_ARENA_SNAPSHOT_VERSION);
+            global_os.permanent_arena_restored = snapshot.loaded;
+            global_os.permanent_arena_relocation = snapshot.relocation;
+        }
+#endif
     }
     
     // NOTE(rjf): OpenGL initialization
@@ -566,10 +621,10 @@ WinMain(HINSTANCE instance, HINSTANCE prev_instance, LPSTR lp_cmd_line, int n_sh
                 WaitMessage();
             }
             
-            while(PeekMessage(&message, 0, 0, 0, PM_REMOVE))
+            while(PeekMessageW(&message, 0, 0, 0, PM_REMOVE))
             {
                 TranslateMessage(&message);
-                DispatchMessage(&message);
+                DispatchMessageW(&message);
             }
         }
         
@@ -643,6 +698,11 @@ WinMain(HINSTANCE instance, HINSTANCE prev_instance, LPSTR lp_cmd_line, int n_sh
     
     ShowWindow(window_handle, SW_HIDE);
     
+#if PERMANENT_ARENA_SNAPSHOT
+    M_ArenaSaveSnapshot(&global_os.permanent_arena, String8FromCString(global_snapshot_path),
+                        PERMANENT_ARENA_SNAPSHOT_VERSION);
+#endif
+    
     W32_AppCodeUnload(&win32_app_code);
     W32_CleanUpOpenGL(&global_device_context);
     
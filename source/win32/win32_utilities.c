@@ -31,6 +31,18 @@ W32_Reserve(u64 size)
     return memory;
 }
 
+internal void *
+W32_ReserveAt(void *address, u64 size)
+{
+    void *memory = VirtualAlloc(address, size, MEM_RESERVE, PAGE_NOACCESS);
+    if(memory && memory != address)
+    {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        memory = 0;
+    }
+    return memory;
+}
+
 internal void
 W32_Release(void *memory)
 {
@@ -49,6 +61,81 @@ W32_Decommit(void *memory, u64 size)
     VirtualFree(memory, size, MEM_DECOMMIT);
 }
 
+// NOTE(rjf): Maps one pagefile-backed section twice, back to back. size must
+// be a multiple of the allocation granularity. Windows can't map a view into
+// a range we hold reserved, so we find a free range, release it and map into
+// it; another thread can take the range in between, so retry a few times.
+internal void *
+W32_ReserveRing(u64 size)
+{
+    void *memory = 0;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, 0, PAGE_READWRITE,
+                                        (DWORD)(size >> 32), (DWORD)(size & 0xffffffff), 0);
+    if(mapping)
+    {
+        for(int attempt = 0; attempt < 16 && !memory; ++attempt)
+        {
+            u8 *address = VirtualAlloc(0, 2*size, MEM_RESERVE, PAGE_NOACCESS);
+            if(address)
+            {
+                VirtualFree(address, 0, MEM_RELEASE);
+                void *first = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address);
+                void *second = first ? MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size, address + size) : 0;
+                if(first && second)
+                {
+                    memory = address;
+                }
+                else if(first)
+                {
+                    UnmapViewOfFile(first);
+                }
+            }
+        }
+        
+        // NOTE(rjf): The views keep the section alive.
+        CloseHandle(mapping);
+    }
+    return memory;
+}
+
+internal void
+W32_ReleaseRing(void *memory, u64 size)
+{
+    UnmapViewOfFile((u8 *)memory + size);
+    UnmapViewOfFile(memory);
+}
+
+// NOTE(rjf): Large pages need SeLockMemoryPrivilege, which has to be granted
+// to the user and then enabled on the process token. Returns the large page
+// size, or 0 if large pages are unavailable.
+internal u64
+W32_EnableLargePages(void)
+{
+    u64 large_page_size = 0;
+    HANDLE token = 0;
+    if(OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    {
+        TOKEN_PRIVILEGES privileges = {0};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        if(LookupPrivilegeValueA(0, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+           AdjustTokenPrivileges(token, FALSE, &privileges, 0, 0, 0) &&
+           GetLastError() == ERROR_SUCCESS)
+        {
+            large_page_size = GetLargePageMinimum();
+        }
+        CloseHandle(token);
+    }
+    return large_page_size;
+}
+
+internal void *
+W32_ReserveLargePages(u64 size)
+{
+    void *memory = VirtualAlloc(0, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+    return memory;
+}
+
 internal void
 W32_OutputError(char *title, char *format, ...)
 {